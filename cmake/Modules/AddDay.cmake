@@ -3,7 +3,7 @@ include(CMakeParseArguments)
 function(AddDay)
     cmake_parse_arguments(
         PUZZLE # prefix of output variables
-        "" # list of names of the boolean arguments (only defined ones will be true)
+        "EMBED_INPUT" # list of names of the boolean arguments (only defined ones will be true)
         "YEAR;DAY" # list of names of mono-valued arguments
         "LIBS" # list of names of multi-valued arguments (output variables are lists)
         ${ARGN} # arguments of the function to parse, here we take the all original ones
@@ -11,10 +11,10 @@ function(AddDay)
 
     set(APP_NAME_PREFIX ${PUZZLE_YEAR}_${PUZZLE_DAY})
 
-    add_executable(${APP_NAME_PREFIX}_app ${PUZZLE_DAY}/main.cpp)
+    add_library(${APP_NAME_PREFIX}_solver OBJECT ${PUZZLE_DAY}/main.cpp)
 
     target_compile_options(
-        ${APP_NAME_PREFIX}_app
+        ${APP_NAME_PREFIX}_solver
         PRIVATE $<$<CXX_COMPILER_ID:MSVC>:
                 -wd4201
                 -wd4996
@@ -25,12 +25,41 @@ function(AddDay)
                 -wd6330>)
 
     target_link_libraries(
-        ${APP_NAME_PREFIX}_app
-        PRIVATE aoc
-                fmt::fmt
-                glm::glm
-                range-v3::meta
-                ${PUZZLE_LIBS})
+        ${APP_NAME_PREFIX}_solver
+        PUBLIC aoc
+               fmt::fmt
+               glm::glm
+               range-v3::meta
+               ${PUZZLE_LIBS})
+
+    set_property(GLOBAL APPEND PROPERTY AOC_SOLVER_TARGETS ${APP_NAME_PREFIX}_solver)
+
+    # compile the day's puzzle.in into every binary with this solver so it can run without file access
+    set(PUZZLE_INPUT ${CMAKE_CURRENT_SOURCE_DIR}/${PUZZLE_DAY}/puzzle.in)
+
+    if(PUZZLE_EMBED_INPUT OR AOC_EMBED_INPUTS)
+        if(EXISTS ${PUZZLE_INPUT})
+            string(REGEX REPLACE "^day0*" "" PUZZLE_DAY_NUMBER ${PUZZLE_DAY})
+            set(EMBEDDED_INPUT_SOURCE ${CMAKE_CURRENT_BINARY_DIR}/${PUZZLE_DAY}_input.cpp)
+
+            add_custom_command(
+                OUTPUT ${EMBEDDED_INPUT_SOURCE}
+                COMMAND
+                    ${CMAKE_COMMAND} -DINPUT=${PUZZLE_INPUT} -DOUTPUT=${EMBEDDED_INPUT_SOURCE}
+                    -DYEAR=${PUZZLE_YEAR} -DDAY=${PUZZLE_DAY_NUMBER} -P
+                    ${PROJECT_SOURCE_DIR}/cmake/Modules/EmbedInput.cmake
+                DEPENDS ${PUZZLE_INPUT} ${PROJECT_SOURCE_DIR}/cmake/Modules/EmbedInput.cmake
+                COMMENT "Embedding ${PUZZLE_YEAR}/${PUZZLE_DAY} puzzle input")
+
+            target_sources(${APP_NAME_PREFIX}_solver PRIVATE ${EMBEDDED_INPUT_SOURCE})
+        elseif(PUZZLE_EMBED_INPUT)
+            message(WARNING "${PUZZLE_INPUT} not found, ${PUZZLE_YEAR}/${PUZZLE_DAY} reads it at runtime")
+        endif()
+    endif()
+
+    add_executable(${APP_NAME_PREFIX}_app)
+
+    target_link_libraries(${APP_NAME_PREFIX}_app PRIVATE aoc_runner_main ${APP_NAME_PREFIX}_solver)
 
     add_executable(${APP_NAME_PREFIX}_tests ${PUZZLE_DAY}/main.cpp)
 
@@ -56,6 +85,10 @@ function(AddDay)
 
     target_compile_definitions(${APP_NAME_PREFIX}_tests PRIVATE UNIT_TESTING)
 
+    if(AOC_TRACK_ALLOCATIONS)
+        target_link_libraries(${APP_NAME_PREFIX}_tests PRIVATE aoc_allocation_hooks)
+    endif()
+
     catch_discover_tests(${APP_NAME_PREFIX}_tests)
 
     add_custom_target(${APP_NAME_PREFIX} DEPENDS ${APP_NAME_PREFIX}_app
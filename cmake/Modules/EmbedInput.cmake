@@ -0,0 +1,30 @@
+# Writes a source file that compiles INPUT into the binary and registers it for YEAR/DAY, see
+# aoc::embedded_input_registrar. Run in script mode: cmake -DINPUT=... -DOUTPUT=... -DYEAR=... -DDAY=... -P
+
+file(READ "${INPUT}" contents HEX)
+
+string(LENGTH "${contents}" hex_length)
+math(EXPR size "${hex_length} / 2")
+
+# 16 bytes per line, plus a trailing NUL so an empty input is still a valid array
+string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1, " bytes "${contents}")
+string(REPEAT "0x[0-9a-f][0-9a-f], " 16 line_pattern)
+string(REGEX REPLACE "(${line_pattern})" "\\1\n    " bytes "${bytes}")
+
+file(
+    WRITE "${OUTPUT}"
+    "// Generated from ${INPUT}, do not edit.\n"
+    "\n"
+    "#include <aoc/runner.hpp>\n"
+    "\n"
+    "namespace {\n"
+    "\n"
+    "constexpr unsigned char input_data[] = {\n"
+    "    ${bytes}0x00};\n"
+    "\n"
+    "const aoc::embedded_input_registrar registrar{\n"
+    "    ${YEAR},\n"
+    "    ${DAY},\n"
+    "    {reinterpret_cast<const char*>(input_data), ${size}}};\n"
+    "\n"
+    "} // namespace\n")
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace aoc::allocations {
+
+// Configure with -DAOC_TRACK_ALLOCATIONS=ON to link counting global operator new/delete into the test
+// targets. Without it nothing is counted and every figure below reads zero.
+#ifdef AOC_TRACK_ALLOCATIONS
+inline constexpr bool enabled = true;
+#else
+inline constexpr bool enabled = false;
+#endif
+
+struct stats {
+    std::uint64_t count = 0;
+    std::uint64_t bytes = 0;
+
+    friend stats operator-(const stats& a, const stats& b)
+    {
+        return {a.count - b.count, a.bytes - b.bytes};
+    }
+};
+
+// Called by the replacement operator new, on every thread.
+void record(std::size_t bytes) noexcept;
+
+// Everything allocated since the program started.
+stats totals() noexcept;
+
+// Everything allocated since the current TEST_CASE started, for asserting allocation budgets:
+//     REQUIRE(aoc::allocations::since_test_start().count <= 10);
+void  mark_test_start() noexcept;
+stats since_test_start() noexcept;
+
+// Allocations made between construction and the call to used().
+class scope {
+public:
+    scope() noexcept
+        : start_{totals()}
+    {
+    }
+
+    stats used() const noexcept { return totals() - start_; }
+
+private:
+    stats start_;
+};
+
+} // namespace aoc::allocations
@@ -1,7 +1,17 @@
 
 #pragma once
 
-#include <iosfwd>
+#include "arena.hpp"
+#include "input.hpp"
+
+#include <concepts>
+#include <cstdint>
+#include <istream>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <range/v3/all.hpp>
@@ -14,20 +24,55 @@ std::vector<T> read_element_per_line(std::istream&& input)
     return ranges::istream_view<T>(input) | ranges::to<std::vector>;
 }
 
+// One element per non-empty line of text, e.g. the contents of a mapped_file. Numbers are parsed in
+// place and string-like elements are built straight from the line views.
 template <typename T>
-std::vector<T> split_line_by(std::istream& input, char delimiter = ',')
+std::vector<T> read_element_per_line(std::string_view input)
 {
-    std::string tmp;
-    std::getline(input, tmp);
+    std::vector<T> elements;
 
-    // clang-format off
-    return tmp | ranges::views::split(delimiter)
-               | ranges::views::transform([](auto&& s) { return s | ranges::to<std::string>; })
-               | ranges::views::transform([](auto&& s) { return std::stoi(s); })
-               | ranges::to<std::vector>;
-    // clang-format on
+    for (auto line : lines(input)) {
+        if (line.empty()) continue;
+
+        if constexpr (std::is_integral_v<T>) { elements.push_back(parse_number<T>(line)); }
+        else {
+            elements.emplace_back(line);
+        }
+    }
+
+    return elements;
+}
+
+template <std::integral T>
+std::vector<T> split_line_by(std::string_view input, char delimiter = ',')
+{
+    auto first_line = *lines(input).begin();
+
+    if constexpr (std::same_as<T, std::int32_t> || std::same_as<T, std::int64_t>) {
+        std::vector<T> elements(count_fields(first_line, delimiter));
+        elements.resize(parse_integer_list(first_line, delimiter, elements));
+
+        return elements;
+    }
+    else {
+        std::vector<T> elements;
+
+        for (auto field : fields(first_line, delimiter)) {
+            elements.push_back(parse_number<T>(field));
+        }
+
+        return elements;
+    }
 }
 
+template <std::integral T>
+std::vector<T> split_line_by(std::istream& input, char delimiter = ',')
+{
+    std::string line;
+    std::getline(input, line);
+
+    return split_line_by<T>(std::string_view{line}, delimiter);
+}
 
 template <typename T>
 auto transpose(const std::vector<std::vector<T>>& grid)
@@ -43,6 +88,46 @@ auto transpose(const std::vector<std::vector<T>>& grid)
     // clang-format on
 }
 
-auto combine_chars = [](auto const& rc) { return rc | ranges::to<std::string>; };
+inline auto combine_chars = [](auto const& rc) { return rc | ranges::to<std::string>; };
+
+namespace detail {
+
+    template <template <typename> typename Container>
+    struct to_arena_fn {
+        arena* scratch;
+
+        template <ranges::input_range Rng>
+        friend auto operator|(Rng&& rng, to_arena_fn fn)
+        {
+            Container<ranges::range_value_t<Rng>> out{fn.scratch->resource()};
+
+            if constexpr (ranges::sized_range<Rng>) {
+                out.reserve(static_cast<std::size_t>(ranges::size(rng)));
+            }
+
+            for (auto&& element : rng) {
+                out.push_back(std::forward<decltype(element)>(element));
+            }
+
+            return out;
+        }
+    };
+
+    template <typename T>
+    using pmr_string = std::pmr::basic_string<T>;
+
+} // namespace detail
+
+// Pipeline terminators that materialize into the given arena instead of the global heap, e.g.
+// rng | aoc::to_vector(aoc::scratch_arena()). The result lives until the arena is reset.
+inline auto to_vector(arena& scratch)
+{
+    return detail::to_arena_fn<std::pmr::vector>{&scratch};
+}
+
+inline auto to_string(arena& scratch)
+{
+    return detail::to_arena_fn<detail::pmr_string>{&scratch};
+}
 
 } // namespace aoc
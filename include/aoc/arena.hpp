@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+namespace aoc {
+
+// Monotonic scratch memory. Containers built on resource() never free individually; reset() drops
+// everything allocated since the last reset at once and keeps the initial block for reuse.
+class arena {
+public:
+    explicit arena(std::size_t initial_size = 64 * 1024)
+        : buffer_{std::make_unique<std::byte[]>(initial_size)}
+        , resource_{buffer_.get(), initial_size}
+    {
+    }
+
+    arena(const arena&)            = delete;
+    arena& operator=(const arena&) = delete;
+
+    std::pmr::memory_resource* resource() noexcept { return &resource_; }
+
+    // Invalidates every container still using this arena.
+    void reset() noexcept { resource_.release(); }
+
+private:
+    std::unique_ptr<std::byte[]>        buffer_;
+    std::pmr::monotonic_buffer_resource resource_;
+};
+
+// Per-thread arena for a solver's scratch containers. Registered solvers find it reset at the start of
+// every solve, so anything built on it must not outlive the solve that built it.
+inline arena& scratch_arena()
+{
+    thread_local arena scratch;
+    return scratch;
+}
+
+} // namespace aoc
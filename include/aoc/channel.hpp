@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+// Keeps the indices one side writes away from the cache line the other side writes.
+inline constexpr std::size_t channel_cache_line = 64;
+
+// Bounded single-producer single-consumer ring buffer. Exactly one thread may push and exactly one
+// thread may pop; neither ever blocks or takes a lock.
+template <typename T>
+class spsc_channel {
+public:
+    explicit spsc_channel(std::size_t capacity = 1024)
+        : mask_{std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1}
+        , slots_(mask_ + 1)
+    {
+    }
+
+    spsc_channel(const spsc_channel&)            = delete;
+    spsc_channel& operator=(const spsc_channel&) = delete;
+
+    // False when the channel is full.
+    bool try_push(T value)
+    {
+        auto tail = tail_.load(std::memory_order_relaxed);
+
+        if (tail - head_cache_ > mask_) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail - head_cache_ > mask_) return false;
+        }
+
+        slots_[tail & mask_] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    std::optional<T> try_pop()
+    {
+        auto head = head_.load(std::memory_order_relaxed);
+
+        if (head == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head == tail_cache_) return std::nullopt;
+        }
+
+        std::optional<T> value{std::move(slots_[head & mask_])};
+        head_.store(head + 1, std::memory_order_release);
+
+        return value;
+    }
+
+    // Only a hint while the other side is active.
+    bool empty() const
+    {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+private:
+    std::size_t    mask_;
+    std::vector<T> slots_;
+
+    alignas(channel_cache_line) std::atomic<std::size_t> head_ = 0;
+    std::size_t tail_cache_                                    = 0;
+
+    alignas(channel_cache_line) std::atomic<std::size_t> tail_ = 0;
+    std::size_t head_cache_                                    = 0;
+};
+
+// Unbounded multi-producer single-consumer queue. Any number of threads may push, each with a single
+// atomic exchange; one thread pops. A pop racing a push that has not finished linking its node may
+// report the channel empty, but once push returns the value is visible to the consumer.
+template <typename T>
+class mpsc_channel {
+public:
+    mpsc_channel()
+        : head_{new node}
+        , tail_{head_.load(std::memory_order_relaxed)}
+    {
+    }
+
+    ~mpsc_channel()
+    {
+        while (tail_ != nullptr) {
+            delete std::exchange(tail_, tail_->next.load(std::memory_order_relaxed));
+        }
+    }
+
+    mpsc_channel(const mpsc_channel&)            = delete;
+    mpsc_channel& operator=(const mpsc_channel&) = delete;
+
+    void push(T value)
+    {
+        auto* n = new node{std::move(value)};
+
+        auto* previous = head_.exchange(n, std::memory_order_acq_rel);
+        previous->next.store(n, std::memory_order_release);
+    }
+
+    std::optional<T> try_pop()
+    {
+        auto* next = tail_->next.load(std::memory_order_acquire);
+        if (next == nullptr) return std::nullopt;
+
+        std::optional<T> value{std::move(next->value)};
+        delete std::exchange(tail_, next);
+
+        return value;
+    }
+
+    // Consumer side only.
+    bool empty() const { return tail_->next.load(std::memory_order_acquire) == nullptr; }
+
+private:
+    struct node {
+        T                  value{};
+        std::atomic<node*> next = nullptr;
+    };
+
+    alignas(channel_cache_line) std::atomic<node*> head_;
+    alignas(channel_cache_line) node* tail_;
+};
+
+} // namespace aoc
@@ -0,0 +1,250 @@
+#pragma once
+
+#include "input.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <range/v3/view/stride.hpp>
+#include <range/v3/view/subrange.hpp>
+
+namespace aoc {
+
+struct grid_point {
+    std::ptrdiff_t row = 0;
+    std::ptrdiff_t col = 0;
+
+    friend bool operator==(const grid_point&, const grid_point&) = default;
+};
+
+inline constexpr std::array<grid_point, 4> neighbors_4 = {{{-1, 0}, {0, -1}, {0, 1}, {1, 0}}};
+
+inline constexpr std::array<grid_point, 8> neighbors_8 = {
+    {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}}};
+
+// Fixed-capacity list of neighbouring points, so asking for neighbours never allocates.
+class neighbor_list {
+public:
+    void push_back(grid_point p) { points_[size_++] = p; }
+
+    const grid_point* begin() const { return points_.data(); }
+    const grid_point* end() const { return points_.data() + size_; }
+    std::size_t       size() const { return size_; }
+
+private:
+    std::array<grid_point, 8> points_{};
+    std::size_t               size_ = 0;
+};
+
+// Dense row-major 2D grid held in one contiguous buffer. An optional border of `padding` cells on every
+// side can be addressed with negative or past-the-end coordinates, so stencils that look one cell out
+// need no bounds checks when the border holds a neutral value. Use char rather than bool for flags, as
+// rows are handed out as spans.
+template <typename T>
+class grid {
+    static_assert(!std::is_same_v<T, bool>, "std::vector<bool> cannot hand out spans, use char instead");
+
+public:
+    grid() = default;
+
+    grid(std::size_t rows, std::size_t cols, const T& value = T{}, std::size_t padding = 0)
+        : rows_{rows}
+        , cols_{cols}
+        , padding_{padding}
+        , cells_((rows + 2 * padding) * (cols + 2 * padding), value)
+    {
+    }
+
+    // One row per line of text, each character converted by to_cell. Every line must have the same
+    // length, a single trailing newline is ignored.
+    template <typename F>
+    static grid parse(std::string_view text, F&& to_cell, std::size_t padding = 0, const T& border = T{})
+    {
+        std::vector<std::string_view> rows;
+        for (auto line : lines(text)) {
+            rows.push_back(line);
+        }
+
+        grid result{rows.size(), rows.empty() ? 0 : rows[0].size(), border, padding};
+
+        for (std::size_t r = 0; r < rows.size(); ++r) {
+            if (rows[r].size() != result.cols_) {
+                throw std::invalid_argument{"Grid rows must all have the same length"};
+            }
+
+            std::ranges::transform(rows[r], result.row(r).begin(), to_cell);
+        }
+
+        return result;
+    }
+
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+    std::size_t padding() const { return padding_; }
+
+    // True for points inside the grid proper, false for the border and beyond.
+    bool contains(std::ptrdiff_t row, std::ptrdiff_t col) const
+    {
+        return row >= 0 && col >= 0 && row < static_cast<std::ptrdiff_t>(rows_)
+               && col < static_cast<std::ptrdiff_t>(cols_);
+    }
+
+    bool contains(grid_point p) const { return contains(p.row, p.col); }
+
+    T&       operator()(std::ptrdiff_t row, std::ptrdiff_t col) { return cells_[index(row, col)]; }
+    const T& operator()(std::ptrdiff_t row, std::ptrdiff_t col) const { return cells_[index(row, col)]; }
+
+    T&       operator[](grid_point p) { return (*this)(p.row, p.col); }
+    const T& operator[](grid_point p) const { return (*this)(p.row, p.col); }
+
+    T& at(std::ptrdiff_t row, std::ptrdiff_t col)
+    {
+        check(row, col);
+        return (*this)(row, col);
+    }
+
+    const T& at(std::ptrdiff_t row, std::ptrdiff_t col) const
+    {
+        check(row, col);
+        return (*this)(row, col);
+    }
+
+    std::span<T>       row(std::size_t r) { return {cells_.data() + row_start(r), cols_}; }
+    std::span<const T> row(std::size_t r) const { return {cells_.data() + row_start(r), cols_}; }
+
+    auto column(std::size_t c) { return column_view(cells_.data(), c); }
+    auto column(std::size_t c) const { return column_view(cells_.data(), c); }
+
+    // The in-grid neighbours of p, or all of them when the border is wide enough to absorb the offsets.
+    template <std::size_t N>
+    neighbor_list neighbors(grid_point p, const std::array<grid_point, N>& offsets) const
+    {
+        neighbor_list result;
+
+        for (auto offset : offsets) {
+            grid_point n{p.row + offset.row, p.col + offset.col};
+            if (padding_ > 0 || contains(n)) { result.push_back(n); }
+        }
+
+        return result;
+    }
+
+    // Sets every cell, border included.
+    void fill(const T& value) { std::ranges::fill(cells_, value); }
+
+    void flip_horizontal()
+    {
+        for (auto first = cells_.begin(); first != cells_.end(); first += stride()) {
+            std::reverse(first, first + stride());
+        }
+    }
+
+    void flip_vertical()
+    {
+        auto height = rows_ + 2 * padding_;
+
+        for (std::size_t r = 0; r < height / 2; ++r) {
+            std::swap_ranges(
+                cells_.begin() + r * stride(),
+                cells_.begin() + (r + 1) * stride(),
+                cells_.begin() + (height - r - 1) * stride());
+        }
+    }
+
+    // Writes the transpose into out, reusing its buffer when it is already large enough.
+    void transpose_into(grid& out) const
+    {
+        out.resize(cols_, rows_, padding_);
+
+        auto height = rows_ + 2 * padding_;
+
+        for (std::size_t r = 0; r < height; ++r) {
+            for (std::size_t c = 0; c < stride(); ++c) {
+                out.cells_[c * height + r] = cells_[r * stride() + c];
+            }
+        }
+    }
+
+    // Square grids are transposed by swapping cells, anything else goes through one temporary buffer.
+    void transpose()
+    {
+        if (rows_ != cols_) {
+            grid tmp;
+            transpose_into(tmp);
+            *this = std::move(tmp);
+            return;
+        }
+
+        for (std::size_t r = 0; r < stride(); ++r) {
+            for (std::size_t c = r + 1; c < stride(); ++c) {
+                std::swap(cells_[r * stride() + c], cells_[c * stride() + r]);
+            }
+        }
+    }
+
+    void rotate_clockwise_into(grid& out) const
+    {
+        transpose_into(out);
+        out.flip_horizontal();
+    }
+
+    void rotate_clockwise()
+    {
+        transpose();
+        flip_horizontal();
+    }
+
+    friend bool operator==(const grid&, const grid&) = default;
+
+private:
+    std::size_t stride() const { return cols_ + 2 * padding_; }
+
+    std::size_t row_start(std::size_t r) const { return (r + padding_) * stride() + padding_; }
+
+    std::size_t index(std::ptrdiff_t row, std::ptrdiff_t col) const
+    {
+        auto p = static_cast<std::ptrdiff_t>(padding_);
+        return static_cast<std::size_t>((row + p) * static_cast<std::ptrdiff_t>(stride()) + col + p);
+    }
+
+    void check(std::ptrdiff_t row, std::ptrdiff_t col) const
+    {
+        auto p = static_cast<std::ptrdiff_t>(padding_);
+        if (row < -p || col < -p || row >= static_cast<std::ptrdiff_t>(rows_) + p
+            || col >= static_cast<std::ptrdiff_t>(cols_) + p) {
+            throw std::out_of_range{"Grid position out of range"};
+        }
+    }
+
+    void resize(std::size_t rows, std::size_t cols, std::size_t padding)
+    {
+        rows_    = rows;
+        cols_    = cols;
+        padding_ = padding;
+        cells_.resize((rows + 2 * padding) * (cols + 2 * padding));
+    }
+
+    template <typename Ptr>
+    auto column_view(Ptr data, std::size_t c) const
+    {
+        auto first = data + row_start(0) + c;
+        auto last  = rows_ == 0 ? first : first + (rows_ - 1) * stride() + 1;
+        auto step  = static_cast<std::ptrdiff_t>(stride());
+
+        return ranges::subrange(first, last) | ranges::views::stride(step);
+    }
+
+    std::size_t    rows_    = 0;
+    std::size_t    cols_    = 0;
+    std::size_t    padding_ = 0;
+    std::vector<T> cells_;
+};
+
+} // namespace aoc
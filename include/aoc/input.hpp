@@ -0,0 +1,184 @@
+#pragma once
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace aoc {
+
+// Read-only memory mapping of a whole file. Views handed out by contents() stay valid for the lifetime
+// of the mapping, so parsers can work on the file in place without copying it into std::strings.
+class mapped_file {
+public:
+    explicit mapped_file(const std::filesystem::path& path);
+    ~mapped_file();
+
+    mapped_file(mapped_file&& other) noexcept;
+    mapped_file& operator=(mapped_file&& other) noexcept;
+
+    mapped_file(const mapped_file&)            = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    std::string_view contents() const noexcept { return {data_, size_}; }
+
+private:
+    void unmap() noexcept;
+
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+#ifdef _WIN32
+    void* file_    = nullptr;
+    void* mapping_ = nullptr;
+#endif
+};
+
+// Lazily splits text on a delimiter, yielding views into the original text. Empty text yields nothing;
+// when splitting on '\n' a trailing '\r' is dropped from every piece.
+class split_view {
+public:
+    class iterator {
+    public:
+        using iterator_concept  = std::forward_iterator_tag;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = std::string_view;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = std::string_view;
+        using pointer           = void;
+
+        iterator() = default;
+
+        iterator(std::string_view text, char delimiter)
+            : rest_{text}
+            , delimiter_{delimiter}
+            , has_rest_{!text.empty()}
+        {
+            advance();
+        }
+
+        std::string_view operator*() const { return current_; }
+
+        iterator& operator++()
+        {
+            advance();
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            auto tmp = *this;
+            advance();
+            return tmp;
+        }
+
+        friend bool operator==(const iterator& a, const iterator& b)
+        {
+            return a.done_ == b.done_ && (a.done_ || a.current_.data() == b.current_.data());
+        }
+
+    private:
+        void advance()
+        {
+            if (!has_rest_) {
+                done_ = true;
+                return;
+            }
+
+            done_    = false;
+            auto pos = rest_.find(delimiter_);
+
+            if (pos == std::string_view::npos) {
+                current_  = rest_;
+                has_rest_ = false;
+            }
+            else {
+                current_ = rest_.substr(0, pos);
+                rest_.remove_prefix(pos + 1);
+            }
+
+            if (delimiter_ == '\n' && !current_.empty() && current_.back() == '\r') {
+                current_.remove_suffix(1);
+            }
+        }
+
+        std::string_view rest_;
+        std::string_view current_;
+        char             delimiter_ = '\n';
+        bool             has_rest_  = false;
+        bool             done_      = true;
+    };
+
+    split_view(std::string_view text, char delimiter)
+        : text_{text}
+        , delimiter_{delimiter}
+    {
+    }
+
+    iterator begin() const { return {text_, delimiter_}; }
+    iterator end() const { return {}; }
+
+private:
+    std::string_view text_;
+    char             delimiter_;
+};
+
+// Every line of text, without line terminators. A final newline does not produce an empty last line.
+inline split_view lines(std::string_view text)
+{
+    if (text.ends_with('\n')) { text.remove_suffix(1); }
+
+    return {text, '\n'};
+}
+
+inline split_view fields(std::string_view line, char delimiter)
+{
+    return {line, delimiter};
+}
+
+// Parses a whole field as a number. Surrounding blanks and a leading '+' are accepted, like std::stoi,
+// but trailing garbage is an error.
+template <std::integral T>
+T parse_number(std::string_view text)
+{
+    auto is_blank = [](char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; };
+
+    while (!text.empty() && is_blank(text.front())) text.remove_prefix(1);
+    while (!text.empty() && is_blank(text.back())) text.remove_suffix(1);
+
+    if (text.starts_with('+')) { text.remove_prefix(1); }
+
+    T    value{};
+    auto end       = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, value);
+
+    if (ec != std::errc{} || ptr != end) {
+        throw std::invalid_argument{"Invalid number: " + std::string{text}};
+    }
+
+    return value;
+}
+
+// Number of times c occurs in text, compared 32 or 16 bytes at a time with AVX2 or SSE2. When text is a
+// view into a larger buffer, such as a line of a mapped_file, passing the whole buffer lets the last
+// partial block be compared at once too, by reading past the end of text but not of buffer.
+std::size_t count_char(std::string_view text, char c);
+std::size_t count_char(std::string_view text, char c, std::string_view buffer);
+
+// Number of fields a delimiter separated list would split into, an upper bound for parse_integer_list.
+std::size_t count_fields(std::string_view text, char delimiter);
+
+// Parses delimiter separated integers into out and returns how many were written. Delimiters are found
+// 32 or 16 bytes at a time with AVX2 or SSE2, plain digit runs are converted without going through
+// from_chars, and anything else falls back to parse_number. When splitting on '\n' blank lines are
+// skipped. Throws std::invalid_argument for a malformed field and std::length_error if out is too small.
+std::size_t parse_integer_list(std::string_view text, char delimiter, std::span<std::int32_t> out);
+std::size_t parse_integer_list(std::string_view text, char delimiter, std::span<std::int64_t> out);
+
+} // namespace aoc
@@ -1,10 +1,304 @@
-
 #pragma once
 
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace aoc {
 
 std::vector<int> compute(std::vector<int> program);
 
-}
+namespace intcode {
+
+    using word = std::int64_t;
+
+    // A comma separated Intcode program, as found in the puzzle inputs.
+    std::vector<word> parse_program(std::string_view text);
+
+    enum class status {
+        ready,
+        waiting_for_input,
+        halted,
+    };
+
+    // How run() executes the program. The interpreter decodes opcode and mode digits on every step. The
+    // threaded engine decodes each instruction once into a cache of resolved operands and dispatches on
+    // it through computed gotos where the compiler supports them, redecoding only the instructions whose
+    // cells the program overwrites. The JIT engine translates straight-line runs of add, multiply and
+    // compare instructions with position or immediate operands, up to and including a closing jump, into
+    // x86-64 machine code and leaves everything else to the interpreter. Translated blocks are dropped
+    // when the program writes into them. Without x86-64 support the JIT engine runs as threaded.
+    enum class engine {
+        interpreter,
+        threaded,
+        jit,
+    };
+
+    // Whether engine::jit translates to native code on this build.
+    bool jit_supported();
+
+    // Copy-on-write paged memory. Copies share the page table and every page until one side writes, so
+    // copying is constant time whatever the size and any number of machines started from one program
+    // image only pay for the pages they modify. Unwritten addresses read as zero.
+    class paged_memory {
+    public:
+        static constexpr std::size_t page_size = 512;
+
+        paged_memory() = default;
+        explicit paged_memory(std::span<const word> contents);
+
+        paged_memory(const paged_memory& other);
+        paged_memory(paged_memory&& other) noexcept;
+        paged_memory& operator=(const paged_memory& other);
+        paged_memory& operator=(paged_memory&& other) noexcept;
+
+        word read(std::size_t address) const
+        {
+            auto index = address / page_size;
+            return index < page_count_ && pages_[index] ? (*pages_[index])[address % page_size] : 0;
+        }
+
+        // Unshares the page holding address, allocating it when it does not exist yet.
+        word& writable(std::size_t address);
+
+        // The cell in whichever page currently holds it, or nullptr when that page does not exist.
+        const word* find(std::size_t address) const
+        {
+            auto index = address / page_size;
+            if (index >= page_count_ || !pages_[index]) return nullptr;
+
+            return &(*pages_[index])[address % page_size];
+        }
+
+        // One past the highest address loaded or written.
+        std::size_t size() const { return size_; }
+
+        // Pages held only by this memory rather than shared with a copy.
+        std::size_t unique_pages() const;
+
+        // Changes whenever a page is allocated or unshared and on every copy, on both sides of it, so
+        // pointers into the pages taken under one generation stay valid and unshared for as long as it
+        // does not change.
+        std::uint64_t generation() const { return generation_.load(std::memory_order_relaxed); }
+
+    private:
+        using page       = std::array<word, page_size>;
+        using page_table = std::vector<std::shared_ptr<page>>;
+
+        static std::uint64_t next_generation();
+
+        // Points the read path at the current table.
+        void sync_pages();
+
+        std::shared_ptr<page_table>  table_;
+        const std::shared_ptr<page>* pages_      = nullptr;
+        std::size_t                  page_count_ = 0;
+        std::size_t                  size_       = 0;
+
+        // Copying a const memory still moves its generation on.
+        mutable std::atomic<std::uint64_t> generation_ = next_generation();
+    };
+
+    class profile;
+
+    namespace detail {
+
+        struct jit_cache;
+
+        // Owns a machine's translated code. Copies start out empty, code is never shared.
+        class jit_cache_ptr {
+        public:
+            jit_cache_ptr() noexcept;
+            jit_cache_ptr(const jit_cache_ptr&) noexcept;
+            jit_cache_ptr(jit_cache_ptr&& other) noexcept;
+            jit_cache_ptr& operator=(const jit_cache_ptr&) noexcept;
+            jit_cache_ptr& operator=(jit_cache_ptr&& other) noexcept;
+            ~jit_cache_ptr();
+
+            jit_cache* get() const { return cache_.get(); }
+            jit_cache& get_or_create();
+            void       reset() noexcept;
+
+            // Drops every translated block that covers address.
+            void invalidate(std::size_t address) noexcept;
+
+        private:
+            std::unique_ptr<jit_cache> cache_;
+        };
+
+    } // namespace detail
+
+    // Intcode machine with every opcode, parameter mode and the relative base. Memory starts as the
+    // program and grows on demand when written past its end, reads past the end see zeroes.
+    //
+    // run() returns when the program halts or executes an input instruction with no input queued. In the
+    // latter case the instruction pointer stays on that instruction, so queueing input and calling run()
+    // again picks up exactly where the machine stopped.
+    class vm {
+    public:
+        vm() = default;
+        explicit vm(
+            std::span<const word> program,
+            intcode::engine       engine = intcode::engine::interpreter);
+
+        // Starts from a shared copy of image.
+        explicit vm(const paged_memory& image, intcode::engine engine = intcode::engine::interpreter);
+
+        // Copies are snapshots. They share every memory page with the original until either side
+        // writes and leave the decode and JIT caches behind, so copying takes the same time whatever the
+        // size of the program. Assigning a copy back restores the machine to it. A copy rebuilds its
+        // caches for the code it reaches, which the JIT engine pays for in translation, so searches that
+        // fork on every step run fastest on the threaded engine.
+        vm(const vm& other);
+        vm(vm&& other)            = default;
+        vm& operator=(const vm& other);
+        vm& operator=(vm&& other) = default;
+
+        // A copy of this machine to explore from independently.
+        vm fork() const { return *this; }
+
+        status run();
+
+        // Executes a single instruction.
+        status step();
+
+        status state() const { return state_; }
+
+        intcode::engine engine() const { return engine_; }
+        void            set_engine(intcode::engine engine) { engine_ = engine; }
+
+        // Counts every instruction run() executes into profile, nullptr stops counting. A profiled
+        // machine runs on the interpreter whatever its engine so every instruction is seen. Copies of
+        // the machine count into the same profile.
+        void              set_profile(intcode::profile* profile) { profile_ = profile; }
+        intcode::profile* attached_profile() const { return profile_; }
+
+        void push_input(word value) { inputs_.push_back(value); }
+
+        bool has_output() const { return !outputs_.empty(); }
+        word pop_output();
+
+        // Moves every pending output out of the machine.
+        std::vector<word> take_outputs();
+
+        // Writable access grows memory to cover the address.
+        word& operator[](std::size_t address);
+        word  operator[](std::size_t address) const { return read(address); }
+
+        word read(std::size_t address) const { return memory_.read(address); }
+
+        const paged_memory& memory() const { return memory_; }
+
+        std::size_t   instruction_pointer() const { return ip_; }
+        word          relative_base() const { return relative_base_; }
+        std::uint64_t instructions_executed() const { return executed_; }
+
+    private:
+        enum class operand_kind : std::uint8_t { position, immediate, relative, invalid };
+
+        struct decoded_instruction {
+            std::uint8_t                op = 0;
+            std::array<operand_kind, 3> kinds{};
+            std::array<word, 3>         operands{};
+        };
+
+        status run_interpreter();
+        status run_profiled();
+        status run_threaded();
+        status run_jit();
+
+        std::size_t parameter_address(int mode, std::size_t offset);
+
+        word  load(int mode, std::size_t offset);
+        word& store(int mode, std::size_t offset);
+
+        const decoded_instruction& fetch() const;
+        void                       decode();
+
+        std::size_t operand_address(const decoded_instruction& d, std::size_t i) const;
+        word        operand(const decoded_instruction& d, std::size_t i) const;
+        void        write_operand(const decoded_instruction& d, std::size_t i, word value);
+
+        void invalidate_code(std::size_t address);
+
+        paged_memory      memory_;
+        std::size_t       ip_            = 0;
+        word              relative_base_ = 0;
+        status            state_         = status::ready;
+        intcode::engine   engine_        = intcode::engine::interpreter;
+        std::uint64_t     executed_      = 0;
+        intcode::profile* profile_       = nullptr;
+        std::deque<word>  inputs_;
+        std::deque<word>  outputs_;
+
+        // Threaded engine cache, indexed by address. code_cells_ marks every cell that some cached
+        // instruction or translated block was decoded from, so writes elsewhere skip the invalidation
+        // check.
+        std::vector<decoded_instruction> decoded_;
+        std::vector<std::uint8_t>        code_cells_;
+
+        detail::jit_cache_ptr jit_;
+    };
+
+    // Runs count independent machines of one program in chunks spread over pool. Every machine starts
+    // from a shared copy of the program, prepare(index, machine) seeds its memory and inputs, and the
+    // result for each index is collect(index, machine) once the machine has stopped.
+    template <typename Prepare, typename Collect>
+    auto run_batch(
+        std::span<const word> program,
+        std::size_t           count,
+        Prepare               prepare,
+        Collect               collect,
+        work_stealing_pool&   pool,
+        intcode::engine       engine = intcode::engine::interpreter)
+    {
+        using result_type = std::invoke_result_t<Collect&, std::size_t, vm&>;
+
+        static_assert(!std::is_same_v<result_type, bool>, "results are written concurrently, use char");
+
+        const paged_memory       image{program};
+        std::vector<result_type> results(count);
+
+        auto chunk = std::max<std::size_t>(1, count / (pool.size() * 4));
+
+        for (std::size_t first = 0; first < count; first += chunk) {
+            pool.submit([&, first, last = std::min(first + chunk, count)] {
+                for (auto index = first; index < last; ++index) {
+                    vm machine{image, engine};
+                    prepare(index, machine);
+                    machine.run();
+                    results[index] = collect(index, machine);
+                }
+            });
+        }
+
+        pool.wait();
+
+        return results;
+    }
+
+    // As above on a pool sized for this machine, collecting every machine's outputs.
+    template <typename Prepare>
+    std::vector<std::vector<word>>
+    run_batch(std::span<const word> program, std::size_t count, Prepare prepare)
+    {
+        work_stealing_pool pool;
+
+        auto outputs = [](std::size_t, vm& machine) { return machine.take_outputs(); };
+
+        return run_batch(program, count, prepare, outputs, pool);
+    }
+
+} // namespace intcode
+
+} // namespace aoc
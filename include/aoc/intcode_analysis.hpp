@@ -0,0 +1,148 @@
+#pragma once
+
+#include "intcode.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace aoc::intcode {
+
+// One instruction of a listing. Operands read [n] in position mode, n in immediate mode and [rb+n] in
+// relative mode. Cells that do not decode to an instruction are listed one at a time as data.
+struct disassembled_instruction {
+    std::size_t address = 0;
+    std::size_t length  = 1;
+    std::string text;
+};
+
+disassembled_instruction disassemble_at(const paged_memory& memory, std::size_t address);
+
+// Decodes instructions back to back from first, which misreads data placed between instructions as code
+// just like the machine would if it ran into it. Stops at last or the end of memory.
+std::vector<disassembled_instruction> disassemble(
+    const paged_memory& memory,
+    std::size_t         first = 0,
+    std::size_t         last  = std::numeric_limits<std::size_t>::max());
+
+// The disassembly with an address and the raw cells on every line.
+std::string listing(
+    const paged_memory& memory,
+    std::size_t         first = 0,
+    std::size_t         last  = std::numeric_limits<std::size_t>::max());
+
+// Execution counts gathered by a vm with the profile attached. Counts are per instruction address, per
+// opcode and per taken jump target, which is where loops start and what a compiling engine would want to
+// translate first.
+class profile {
+public:
+    void record(std::size_t address, word instruction)
+    {
+        if (address >= by_address_.size()) {
+            by_address_.resize(std::max(address + 1, by_address_.size() * 2));
+        }
+
+        ++by_address_[address];
+        ++by_opcode_[static_cast<std::size_t>(instruction % 100 + 100) % 100];
+        ++total_;
+    }
+
+    void record_jump(std::size_t target)
+    {
+        if (target >= jumps_to_.size()) {
+            jumps_to_.resize(std::max(target + 1, jumps_to_.size() * 2));
+        }
+
+        ++jumps_to_[target];
+    }
+
+    std::uint64_t total() const { return total_; }
+
+    std::uint64_t executions(std::size_t address) const
+    {
+        return address < by_address_.size() ? by_address_[address] : 0;
+    }
+
+    // Opcode 99 counts halts. Invalid opcodes are counted under their last two digits.
+    std::uint64_t opcode_executions(int opcode) const
+    {
+        return opcode >= 0 && opcode < 100 ? by_opcode_[static_cast<std::size_t>(opcode)] : 0;
+    }
+
+    std::uint64_t jumps_to(std::size_t target) const
+    {
+        return target < jumps_to_.size() ? jumps_to_[target] : 0;
+    }
+
+    // The count most executed addresses and most jumped to targets, busiest first.
+    std::vector<std::pair<std::size_t, std::uint64_t>> hot_addresses(std::size_t count) const;
+    std::vector<std::pair<std::size_t, std::uint64_t>> hot_jump_targets(std::size_t count) const;
+
+    // A flat profile in the style of gprof: the busiest instructions with their share of the run and
+    // their disassembly from memory, then the opcode mix and the hottest jump targets.
+    std::string flat(const paged_memory& memory, std::size_t rows = 20) const;
+
+    void clear();
+
+private:
+    std::vector<std::uint64_t>     by_address_;
+    std::array<std::uint64_t, 100> by_opcode_{};
+    std::vector<std::uint64_t>     jumps_to_;
+    std::uint64_t                  total_ = 0;
+};
+
+// Polynomial with word coefficients over the variables x0, x1, ..., the value of a cell after a symbolic
+// run. Arithmetic that overflows a word throws std::overflow_error.
+class polynomial {
+public:
+    polynomial() = default;
+    polynomial(word constant); // NOLINT: constants convert implicitly, like the cells they come from
+
+    static polynomial variable(std::size_t index);
+
+    bool is_constant() const;
+    word constant_term() const;
+
+    // Highest power of variable in any term.
+    unsigned degree(std::size_t variable) const;
+
+    word evaluate(std::span<const word> values) const;
+
+    // Fixes variable to value, leaving the others free.
+    polynomial substitute(std::size_t variable, word value) const;
+
+    // Terms by ascending degree, for example "5 + 3*x0 + x0*x1^2".
+    std::string to_string() const;
+
+    friend polynomial operator+(const polynomial& a, const polynomial& b);
+    friend polynomial operator*(const polynomial& a, const polynomial& b);
+
+    friend bool operator==(const polynomial&, const polynomial&) = default;
+
+private:
+    // Exponent of every variable up to the last one present, and the coefficient. No zero coefficients.
+    using exponents = std::vector<unsigned>;
+
+    std::map<exponents, word> terms_;
+};
+
+// Memory after a symbolic run, nullopt where a cell's value is not known.
+using symbolic_memory = std::vector<std::optional<polynomial>>;
+
+// Runs program with cell unknown_cells[i] holding the variable xi instead of a number and returns its
+// memory, as polynomials in those variables, once it halts. Only add and multiply in position and
+// immediate mode are followed. A read through an address that depends on a variable gives a value that
+// is not known, which is fine as long as nothing relies on it. Any other instruction, an opcode or write
+// address that is not a known number, or an overflow returns nullopt.
+std::optional<symbolic_memory>
+run_symbolic(std::span<const word> program, std::span<const std::size_t> unknown_cells);
+
+} // namespace aoc::intcode
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "channel.hpp"
+#include "intcode.hpp"
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace aoc::intcode {
+
+// Many machines exchanging values through lock-free mailboxes. Every output a machine produces is handed
+// to the router, which forwards it with send() to any machine, including the one that produced it.
+//
+// A machine that runs out of input parks without holding a thread, and send() wakes it by scheduling it
+// again. The network is idle once every machine has halted or parked with an empty mailbox, which is
+// when run() returns. More values can then be sent and the network run again.
+class network {
+public:
+    // Called for every output, on whichever thread ran the machine that produced it. On a pool several
+    // machines route concurrently.
+    using router = std::function<void(network& net, std::size_t from, word value)>;
+
+    struct statistics {
+        std::uint64_t messages = 0;
+
+        // From the last machine parking to run() returning, for the most recent run.
+        std::chrono::nanoseconds idle_detection_latency{};
+    };
+
+    explicit network(router route);
+
+    network(const network&)            = delete;
+    network& operator=(const network&) = delete;
+
+    // Returns the new machine's index.
+    std::size_t
+    add(std::span<const word> program, intcode::engine engine = intcode::engine::interpreter);
+
+    // Queues value for machine to and wakes it if it is parked. Safe to call from routers while the
+    // network runs on a pool, and from any thread between runs.
+    void send(std::size_t to, word value);
+
+    // Runs every runnable machine on the calling thread, one at a time, until the network is idle.
+    void run();
+
+    // As above, spreading machines over pool.
+    void run(work_stealing_pool& pool);
+
+    std::size_t size() const { return nodes_.size(); }
+
+    // Only while the network is not running.
+    vm&       machine(std::size_t index) { return nodes_[index]->machine; }
+    const vm& machine(std::size_t index) const { return nodes_[index]->machine; }
+
+    statistics stats() const;
+
+private:
+    struct node {
+        explicit node(vm m)
+            : machine{std::move(m)}
+        {
+        }
+
+        vm                 machine;
+        mpsc_channel<word> mailbox;
+        std::atomic<bool>  scheduled = false;
+    };
+
+    void schedule(std::size_t index);
+    void run_node(std::size_t index);
+    void start();
+    void finish();
+
+    std::vector<std::unique_ptr<node>> nodes_;
+    router                             route_;
+
+    // Runnable machines when running cooperatively.
+    std::deque<std::size_t> ready_;
+    work_stealing_pool*     pool_ = nullptr;
+
+    std::atomic<std::uint64_t> messages_       = 0;
+    std::atomic<std::int64_t>  last_park_      = 0;
+    std::chrono::nanoseconds   idle_detection_ = {};
+};
+
+} // namespace aoc::intcode
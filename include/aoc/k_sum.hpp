@@ -0,0 +1,231 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+namespace detail {
+
+    template <std::integral T>
+    struct value_count {
+        T           value;
+        std::size_t count;
+    };
+
+    template <std::integral T>
+    std::int64_t as_sum(T value)
+    {
+        return static_cast<std::int64_t>(value);
+    }
+
+    // Distance from low to value, which fits an unsigned 64 bit integer for any integral type.
+    template <std::integral T>
+    std::uint64_t offset_from(T low, T value)
+    {
+        return static_cast<std::uint64_t>(value) - static_cast<std::uint64_t>(low);
+    }
+
+    // Distinct values in ascending order with how often each occurs. Values spanning a range not much
+    // larger than their number are counted in a dense table indexed by value in O(n + range), anything
+    // else is sorted.
+    template <std::integral T>
+    std::vector<value_count<T>> count_values(std::vector<T> values)
+    {
+        std::vector<value_count<T>> counted;
+        if (values.empty()) return counted;
+
+        auto [low, high] = std::ranges::minmax(values);
+        auto range       = offset_from(low, high);
+
+        if (range < values.size() * 4 + 1024) {
+            std::vector<std::size_t> table(static_cast<std::size_t>(range) + 1);
+            for (auto value : values) {
+                ++table[static_cast<std::size_t>(offset_from(low, value))];
+            }
+
+            for (std::size_t offset = 0; offset < table.size(); ++offset) {
+                if (table[offset] != 0) {
+                    auto value = static_cast<T>(static_cast<std::uint64_t>(low) + offset);
+                    counted.push_back({value, table[offset]});
+                }
+            }
+
+            return counted;
+        }
+
+        std::ranges::sort(values);
+
+        for (auto value : values) {
+            if (counted.empty() || counted.back().value != value) { counted.push_back({value, 1}); }
+            else {
+                ++counted.back().count;
+            }
+        }
+
+        return counted;
+    }
+
+    // Picks values in ascending order, so every combination of values is found exactly once, and
+    // prunes on the smallest and largest sums the remaining picks could still make.
+    template <std::integral T, typename Report>
+    class k_sum_search {
+    public:
+        k_sum_search(std::vector<value_count<T>> counted, Report& report)
+            : counted_{std::move(counted)}
+            , report_{report}
+        {
+        }
+
+        bool search(std::size_t from, std::size_t k, std::int64_t target)
+        {
+            if (k == 0) return target != 0 || report();
+            if (k == 1) return pick_one(from, target);
+            if (k == 2) return pick_two(from, target);
+
+            for (auto i = from; i < counted_.size(); ++i) {
+                auto value = as_sum(counted_[i].value);
+
+                if (value * static_cast<std::int64_t>(k) > target) break;
+                if (value + largest() * static_cast<std::int64_t>(k - 1) < target) continue;
+
+                if (!with(i, [&] { return search(i, k - 1, target - value); })) return false;
+            }
+
+            return true;
+        }
+
+    private:
+        std::int64_t largest() const { return as_sum(counted_.back().value); }
+
+        bool report() { return report_(std::span<const T>{chosen_}); }
+
+        // Picks counted_[i] for the duration of next, which sees it used up once more.
+        template <typename Next>
+        bool with(std::size_t i, Next next)
+        {
+            if (counted_[i].count == 0) return true;
+
+            --counted_[i].count;
+            chosen_.push_back(counted_[i].value);
+
+            auto keep_going = next();
+
+            chosen_.pop_back();
+            ++counted_[i].count;
+
+            return keep_going;
+        }
+
+        bool pick_one(std::size_t from, std::int64_t target)
+        {
+            auto first = counted_.begin() + static_cast<std::ptrdiff_t>(from);
+            auto found = std::ranges::lower_bound(first, counted_.end(), target, {}, [](const auto& c) {
+                return as_sum(c.value);
+            });
+
+            if (found == counted_.end() || as_sum(found->value) != target) return true;
+
+            return with(static_cast<std::size_t>(found - counted_.begin()), [this] { return report(); });
+        }
+
+        // Two pointers closing in from both ends of what is left.
+        bool pick_two(std::size_t from, std::int64_t target)
+        {
+            if (from >= counted_.size()) return true;
+
+            for (std::size_t i = from, j = counted_.size() - 1; i <= j;) {
+                auto sum = as_sum(counted_[i].value) + as_sum(counted_[j].value);
+
+                if (sum < target) { ++i; }
+                else if (sum > target) {
+                    if (j == 0) break;
+                    --j;
+                }
+                else {
+                    if (!with(i, [&] { return with(j, [this] { return report(); }); })) return false;
+
+                    if (j == 0) break;
+                    ++i;
+                    --j;
+                }
+            }
+
+            return true;
+        }
+
+        std::vector<value_count<T>> counted_;
+        std::vector<T>              chosen_;
+        Report&                     report_;
+    };
+
+} // namespace detail
+
+// Calls visit with every combination of k elements of values that sums to target, as a span of the
+// values in ascending order. Combinations are told apart by their values, so a value can appear as many
+// times as it occurs in values but the same combination is never visited twice. visit returns false to
+// stop the search early.
+//
+// Sorted two-pointer search makes pairs O(n) and triples O(n^2) in the number of distinct values, which
+// for values in a bounded range is at most the size of that range. Sums are taken in std::int64_t, which
+// must hold them.
+template <std::ranges::input_range R, typename Visit>
+    requires std::integral<std::ranges::range_value_t<R>>
+void for_each_k_sum(R&& values, std::size_t k, std::int64_t target, Visit visit)
+{
+    using T = std::ranges::range_value_t<R>;
+
+    std::vector<T> copy(std::ranges::begin(values), std::ranges::end(values));
+
+    auto counted = detail::count_values(std::move(copy));
+    if (counted.empty() && k != 0) return;
+
+    auto report = [&visit](std::span<const T> solution) -> bool { return visit(solution); };
+
+    detail::k_sum_search<T, decltype(report)> search{std::move(counted), report};
+    search.search(0, k, target);
+}
+
+// The first combination found of k elements of values that sums to target, in ascending order.
+template <std::ranges::input_range R>
+    requires std::integral<std::ranges::range_value_t<R>>
+std::optional<std::vector<std::ranges::range_value_t<R>>>
+first_k_sum(R&& values, std::size_t k, std::int64_t target)
+{
+    using T = std::ranges::range_value_t<R>;
+
+    std::optional<std::vector<T>> found;
+    for_each_k_sum(std::forward<R>(values), k, target, [&found](std::span<const T> solution) {
+        found.emplace(solution.begin(), solution.end());
+        return false;
+    });
+
+    return found;
+}
+
+// Every combination of k elements of values that sums to target, each in ascending order.
+template <std::ranges::input_range R>
+    requires std::integral<std::ranges::range_value_t<R>>
+std::vector<std::vector<std::ranges::range_value_t<R>>>
+all_k_sums(R&& values, std::size_t k, std::int64_t target)
+{
+    using T = std::ranges::range_value_t<R>;
+
+    std::vector<std::vector<T>> found;
+    for_each_k_sum(std::forward<R>(values), k, target, [&found](std::span<const T> solution) {
+        found.emplace_back(solution.begin(), solution.end());
+        return true;
+    });
+
+    return found;
+}
+
+} // namespace aoc
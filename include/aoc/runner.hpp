@@ -0,0 +1,98 @@
+#pragma once
+
+#include "arena.hpp"
+#include "input.hpp"
+
+#include <fmt/format.h>
+
+#include <filesystem>
+#include <functional>
+#include <istream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+using solver_fn = std::function<std::string(std::string_view)>;
+
+struct solver_entry {
+    int       year;
+    int       day;
+    int       part;
+    solver_fn solve;
+};
+
+std::vector<solver_entry>& solver_registry();
+
+// Puzzle input for one day, either compiled into the binary or mapped from disk.
+class puzzle_input {
+public:
+    explicit puzzle_input(std::string_view embedded)
+        : contents_{embedded}
+    {
+    }
+
+    // the mapping does not move with the mapped_file, so contents_ stays valid across moves
+    explicit puzzle_input(mapped_file file)
+        : file_{std::move(file)}
+        , contents_{file_->contents()}
+    {
+    }
+
+    std::string_view contents() const noexcept { return contents_; }
+    bool             is_embedded() const noexcept { return !file_.has_value(); }
+
+private:
+    std::optional<mapped_file> file_;
+    std::string_view           contents_;
+};
+
+void register_embedded_input(int year, int day, std::string_view contents);
+
+// The input compiled in with AddDay(... EMBED_INPUT) or AOC_EMBED_INPUTS, if any.
+std::optional<std::string_view> embedded_input(int year, int day);
+
+// The embedded input when there is one, otherwise input_dir/YYYY/dayNN/puzzle.in mapped from disk, or
+// nothing if there is no such file.
+std::optional<puzzle_input> load_puzzle_input(const std::filesystem::path& input_dir, int year, int day);
+
+struct embedded_input_registrar {
+    embedded_input_registrar(int year, int day, std::string_view contents)
+    {
+        register_embedded_input(year, day, contents);
+    }
+};
+
+// Registers one solver per part, in order, for the given puzzle. A part takes the puzzle input either as
+// a std::string_view into the mapped file or as a fresh std::istream over a copy of it, and may return
+// anything fmt can format. The calling thread's scratch_arena() is reset before every call.
+struct solver_registrar {
+    template <typename... Parts>
+    solver_registrar(int year, int day, Parts&&... parts)
+    {
+        int part = 0;
+
+        auto format_result = [](auto fn) {
+            return [fn = std::move(fn)](std::string_view input) {
+                scratch_arena().reset();
+
+                if constexpr (std::is_invocable_v<decltype(fn)&, std::string_view>) {
+                    return fmt::format("{}", fn(input));
+                }
+                else {
+                    std::istringstream iss{std::string{input}};
+                    return fmt::format("{}", fn(iss));
+                }
+            };
+        };
+
+        (solver_registry().push_back({year, day, ++part, format_result(std::forward<Parts>(parts))}), ...);
+    }
+};
+
+} // namespace aoc
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace aoc {
+
+// Fixed-size pool where every worker owns a task deque. Workers pop their own newest task and steal the
+// oldest task from a sibling when they run dry, so one long task never holds up the rest of the queue.
+class work_stealing_pool {
+public:
+    using task = std::function<void()>;
+
+    explicit work_stealing_pool(std::size_t thread_count = std::thread::hardware_concurrency());
+    ~work_stealing_pool();
+
+    work_stealing_pool(const work_stealing_pool&)            = delete;
+    work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+
+    void submit(task t);
+
+    // Blocks until every submitted task has finished, rethrowing the first exception a task raised.
+    void wait();
+
+    std::size_t size() const { return threads_.size(); }
+
+private:
+    struct worker_queue {
+        std::mutex       mutex;
+        std::deque<task> tasks;
+    };
+
+    bool pop_local(std::size_t index, task& t);
+    bool steal(std::size_t thief, task& t);
+    void run(std::size_t index);
+
+    std::vector<std::unique_ptr<worker_queue>> queues_;
+    std::vector<std::thread>                   threads_;
+
+    std::mutex              mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable all_done_;
+    std::size_t             queued_     = 0;
+    std::size_t             unfinished_ = 0;
+    bool                    stopping_   = false;
+    std::exception_ptr      first_error_;
+
+    std::atomic<std::size_t> next_queue_ = 0;
+};
+
+} // namespace aoc
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace aoc::trace {
+
+// Configure with -DAOC_ENABLE_TRACE=ON to compile the AOC_TRACE_* macros in. Without it they expand to
+// nothing and do not evaluate their arguments.
+#ifdef AOC_TRACE
+inline constexpr bool enabled = true;
+#else
+inline constexpr bool enabled = false;
+#endif
+
+struct timer_data {
+    std::atomic<std::uint64_t> calls    = 0;
+    std::atomic<std::uint64_t> total_ns = 0;
+    std::atomic<std::uint64_t> max_ns   = 0;
+
+    void record(std::uint64_t ns)
+    {
+        calls.fetch_add(1, std::memory_order_relaxed);
+        total_ns.fetch_add(ns, std::memory_order_relaxed);
+
+        auto max = max_ns.load(std::memory_order_relaxed);
+        while (ns > max && !max_ns.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {}
+    }
+};
+
+struct counter_data {
+    std::atomic<std::int64_t> value = 0;
+
+    void add(std::int64_t n) { value.fetch_add(n, std::memory_order_relaxed); }
+};
+
+// Log2-bucketed distribution of non-negative samples: bucket i holds values of bit width i.
+struct histogram_data {
+    static constexpr std::size_t bucket_count = std::numeric_limits<std::uint64_t>::digits + 1;
+
+    std::array<std::atomic<std::uint64_t>, bucket_count> buckets{};
+
+    std::atomic<std::uint64_t> samples = 0;
+    std::atomic<std::uint64_t> sum     = 0;
+    std::atomic<std::uint64_t> min     = std::numeric_limits<std::uint64_t>::max();
+    std::atomic<std::uint64_t> max     = 0;
+
+    void record(std::uint64_t value);
+};
+
+// Named instruments live for the rest of the program, so call sites may cache the references.
+timer_data&     timer(std::string_view name);
+counter_data&   counter(std::string_view name);
+histogram_data& histogram(std::string_view name);
+
+// Zeroes every instrument without forgetting them.
+void reset();
+
+std::string report_text();
+std::string report_json();
+
+class scoped_timer {
+public:
+    explicit scoped_timer(timer_data& timer)
+        : timer_{timer}
+        , start_{std::chrono::steady_clock::now()}
+    {
+    }
+
+    ~scoped_timer()
+    {
+        auto elapsed = std::chrono::steady_clock::now() - start_;
+        timer_.record(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+    scoped_timer(const scoped_timer&)            = delete;
+    scoped_timer& operator=(const scoped_timer&) = delete;
+
+private:
+    timer_data&                           timer_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace aoc::trace
+
+#define AOC_TRACE_CONCAT_IMPL(a, b) a##b
+#define AOC_TRACE_CONCAT(a, b) AOC_TRACE_CONCAT_IMPL(a, b)
+
+// Names must be string literals or otherwise constant, each call site looks its instrument up only once.
+#ifdef AOC_TRACE
+#define AOC_TRACE_SCOPE(name)                                                                           \
+    static auto& AOC_TRACE_CONCAT(aoc_trace_timer_, __LINE__) = ::aoc::trace::timer(name);              \
+    const ::aoc::trace::scoped_timer AOC_TRACE_CONCAT(aoc_trace_scope_, __LINE__)(                      \
+        AOC_TRACE_CONCAT(aoc_trace_timer_, __LINE__))
+#define AOC_TRACE_COUNT(name, n)                                                                        \
+    do {                                                                                                \
+        static auto& aoc_trace_counter = ::aoc::trace::counter(name);                                   \
+        aoc_trace_counter.add(static_cast<std::int64_t>(n));                                            \
+    } while (false)
+#define AOC_TRACE_SAMPLE(name, value)                                                                   \
+    do {                                                                                                \
+        static auto& aoc_trace_histogram = ::aoc::trace::histogram(name);                               \
+        aoc_trace_histogram.record(static_cast<std::uint64_t>(value));                                  \
+    } while (false)
+#else
+#define AOC_TRACE_SCOPE(name) static_cast<void>(0)
+#define AOC_TRACE_COUNT(name, n) static_cast<void>(0)
+#define AOC_TRACE_SAMPLE(name, value) static_cast<void>(0)
+#endif
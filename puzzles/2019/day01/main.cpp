@@ -1,55 +1,170 @@
 #include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
-#include <fstream>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AOC_HAS_SSE2
+#endif
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 
+namespace {
+
 int fuel_for_mass(int mass)
 {
     return (mass / 3) - 2;
 }
 
+// Fuel for the module, then for that fuel and so on until the extra fuel needed is nothing.
 int fuel_for_module(int module_mass)
 {
-    // clang-format off
-    return rs::accumulate(
-        rv::iota(0) 
-            | rv::exclusive_scan(module_mass, [](auto i, auto) { return fuel_for_mass(i); })
-            | rv::tail 
-            | rv::take_while([](int i) { return i > 0; }),
-        0);
-    // clang-format on
+    int total = 0;
+    for (auto fuel = fuel_for_mass(module_mass); fuel > 0; fuel = fuel_for_mass(fuel)) {
+        total += fuel;
+    }
+
+    return total;
 }
 
-int part1(std::vector<int>& module_masses)
+// Fuel for many modules at once, lanes modules at a time. Every lane steps mass / 3 - 2 together until
+// all of them reach zero, clamping at zero so that the loop has no branches per module. A module's own
+// total is under half its mass, so fits its 32 bit lane, and the running totals are 64 bit.
+#if defined(AOC_HAS_SSE2)
+
+// Divides four unsigned lanes below 2^31 by 3, as a multiply by 2^33 / 3 and a shift on each pair.
+__m128i divide_by_3(__m128i x)
 {
-    return rs::accumulate(module_masses | rv::transform(fuel_for_mass), 0);
+    const auto magic = _mm_set1_epi32(static_cast<int>(0xAAAAAAAB));
+
+    auto even = _mm_srli_epi64(_mm_mul_epu32(x, magic), 33);
+    auto odd  = _mm_srli_epi64(_mm_mul_epu32(_mm_srli_epi64(x, 32), magic), 33);
+
+    return _mm_or_si128(even, _mm_slli_epi64(odd, 32));
 }
 
-int part2(std::vector<int>& module_masses)
+std::int64_t total_fuel_for_modules(std::span<const int> module_masses)
 {
-    return rs::accumulate(module_masses | rv::transform(fuel_for_module), 0);
+    // Four vectors of four lanes, to keep several multiplies in flight.
+    constexpr std::size_t vectors = 4;
+    constexpr std::size_t lanes   = vectors * 4;
+
+    const auto two  = _mm_set1_epi32(2);
+    const auto zero = _mm_setzero_si128();
+
+    auto totals = _mm_setzero_si128();
+
+    for (std::size_t first = 0; first < module_masses.size(); first += lanes) {
+        auto count = std::min(lanes, module_masses.size() - first);
+
+        alignas(16) std::array<std::int32_t, lanes> block{};
+        for (std::size_t i = 0; i < count; ++i) {
+            block[i] = std::max(module_masses[first + i], 0);
+        }
+
+        __m128i mass[vectors];
+        __m128i fuel[vectors];
+
+        for (std::size_t v = 0; v < vectors; ++v) {
+            mass[v] = _mm_load_si128(reinterpret_cast<const __m128i*>(block.data() + v * 4));
+            fuel[v] = zero;
+        }
+
+        for (auto remaining = zero;; remaining = zero) {
+            for (std::size_t v = 0; v < vectors; ++v) {
+                auto third = divide_by_3(mass[v]);
+
+                mass[v]   = _mm_and_si128(_mm_sub_epi32(third, two), _mm_cmpgt_epi32(third, two));
+                fuel[v]   = _mm_add_epi32(fuel[v], mass[v]);
+                remaining = _mm_or_si128(remaining, mass[v]);
+            }
+
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(remaining, zero)) == 0xFFFF) break;
+        }
+
+        for (std::size_t v = 0; v < vectors; ++v) {
+            totals = _mm_add_epi64(totals, _mm_unpacklo_epi32(fuel[v], zero));
+            totals = _mm_add_epi64(totals, _mm_unpackhi_epi32(fuel[v], zero));
+        }
+    }
+
+    alignas(16) std::array<std::uint64_t, 2> halves;
+    _mm_store_si128(reinterpret_cast<__m128i*>(halves.data()), totals);
+
+    return static_cast<std::int64_t>(halves[0] + halves[1]);
 }
 
-#ifndef UNIT_TESTING
+#else
 
-int main()
+std::int64_t total_fuel_for_modules(std::span<const int> module_masses)
 {
-    fmt::print("Advent of Code 2019 - Day 01\n");
+    constexpr std::size_t lanes = 16;
 
-    auto module_masses = aoc::read_element_per_line<int>(std::ifstream{"puzzle.in"});
+    std::array<std::uint64_t, lanes> totals{};
 
-    fmt::print("Part 1 Solution: {}\n", part1(module_masses));
-    fmt::print("Part 2 Solution: {}\n", part2(module_masses));
+    for (std::size_t first = 0; first < module_masses.size(); first += lanes) {
+        auto count = std::min(lanes, module_masses.size() - first);
 
-    return 0;
+        std::array<std::uint32_t, lanes> mass{};
+        std::array<std::uint32_t, lanes> fuel{};
+
+        for (std::size_t i = 0; i < count; ++i) {
+            mass[i] = static_cast<std::uint32_t>(std::max(module_masses[first + i], 0));
+        }
+
+        for (std::uint32_t remaining = 1; remaining != 0;) {
+            remaining = 0;
+
+            for (std::size_t i = 0; i < lanes; ++i) {
+                mass[i] = std::max(mass[i] / 3, 2u) - 2;
+                fuel[i] += mass[i];
+                remaining |= mass[i];
+            }
+        }
+
+        for (std::size_t i = 0; i < lanes; ++i) {
+            totals[i] += fuel[i];
+        }
+    }
+
+    std::uint64_t total = 0;
+    for (auto t : totals) {
+        total += t;
+    }
+
+    return static_cast<std::int64_t>(total);
 }
 
-#else
+#endif
+
+int part1(const std::vector<int>& module_masses)
+{
+    return rs::accumulate(module_masses | rv::transform(fuel_for_mass), 0);
+}
+
+std::int64_t part2(const std::vector<int>& module_masses)
+{
+    return total_fuel_for_modules(module_masses);
+}
+
+const aoc::solver_registrar registrar{
+    2019,
+    1,
+    [](std::string_view input) { return part1(aoc::read_element_per_line<int>(input)); },
+    [](std::string_view input) { return part2(aoc::read_element_per_line<int>(input)); }};
+
+} // namespace
+
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -68,4 +183,22 @@ TEST_CASE("Calculate fuel for module")
     REQUIRE(50346 == fuel_for_module(100756));
 }
 
+TEST_CASE("Batched fuel matches fuel for each module")
+{
+    // Not a whole number of lanes, with masses too light to need fuel and one that is negative.
+    std::vector<int> masses{-7, 0, 5, 8, 9, 14, 1969, 100756};
+    for (int mass = 1; masses.size() < 1000; mass = mass * 7 % 1000003) {
+        masses.push_back(mass);
+    }
+
+    std::int64_t expected = 0;
+    for (auto mass : masses) {
+        expected += fuel_for_module(mass);
+    }
+
+    REQUIRE(expected == part2(masses));
+    REQUIRE(0 == part2({}));
+    REQUIRE(51314 == part2({14, 1969, 100756}));
+}
+
 #endif
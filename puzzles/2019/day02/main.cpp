@@ -1,79 +1,144 @@
 
 #include <aoc/aoc.hpp>
 #include <aoc/intcode.hpp>
-
-#include <fmt/format.h>
-#include <range/v3/all.hpp>
-
-#include <fstream>
+#include <aoc/intcode_analysis.hpp>
+#include <aoc/runner.hpp>
+#include <aoc/thread_pool.hpp>
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
 #include <vector>
 
-namespace rs = ranges;
-namespace rv = ranges::views;
+namespace {
+
+using aoc::intcode::word;
 
-int compute(std::vector<int> program, int noun, int verb)
+word compute(const std::vector<word>& program, word noun, word verb)
 {
-    program[1] = noun;
-    program[2] = verb;
+    aoc::intcode::vm machine{program};
 
-    program = aoc::compute(program);
+    machine[1] = noun;
+    machine[2] = verb;
 
-    return program[0];
-}
+    machine.run();
 
-auto compute_with_noun_and_verb(const std::vector<int>& program)
-{
-    return [&program](auto&& p) {
-        auto [noun, verb] = p;
-        return std::make_tuple(noun, verb, compute(program, noun, verb));
-    };
+    return machine[0];
 }
 
-auto keep_output_match(int keep_result)
+word part1(const std::vector<word>& program)
 {
-    return [keep_result](const auto& t) {
-        auto [_, __, result] = t;
-        return result == keep_result;
-    };
+    return compute(program, 12, 2);
 }
 
-#ifndef UNIT_TESTING
+constexpr word target = 19690720;
 
-int part1(std::vector<int> program)
+// Runs every noun and verb at once, machine 100 * noun + verb trying that pair.
+word brute_force(const std::vector<word>& program)
 {
-    return compute(program, 12, 2);
+    aoc::work_stealing_pool pool;
+
+    auto outputs = aoc::intcode::run_batch(
+        program,
+        100 * 100,
+        [](std::size_t index, aoc::intcode::vm& machine) {
+            machine[1] = static_cast<word>(index / 100);
+            machine[2] = static_cast<word>(index % 100);
+        },
+        [](std::size_t, aoc::intcode::vm& machine) { return machine[0]; },
+        pool);
+
+    auto match = std::ranges::find(outputs, target);
+    if (match == outputs.end()) throw std::runtime_error{"No noun and verb produce 19690720"};
+
+    return static_cast<word>(match - outputs.begin());
 }
 
-int part2(std::vector<int> program)
+// Solves output(noun, verb) == target, with output as a polynomial in x0 = noun and x1 = verb. Each noun
+// leaves a polynomial in the verb alone, solved directly when it is linear and by trying every verb
+// otherwise.
+std::optional<word> solve(const aoc::intcode::polynomial& output)
 {
-    auto matches = rv::cartesian_product(rv::iota(0, 99), rv::iota(0, 99))
-                   | rv::transform(compute_with_noun_and_verb(program))
-                   | rv::filter(keep_output_match(19690720));
+    for (word noun = 0; noun < 100; ++noun) {
+        auto in_verb = output.substitute(0, noun);
+
+        if (in_verb.degree(1) > 1) {
+            for (word verb = 0; verb < 100; ++verb) {
+                if (in_verb.evaluate(std::array{noun, verb}) == target) return 100 * noun + verb;
+            }
+
+            continue;
+        }
+
+        auto constant = in_verb.constant_term();
+        auto slope    = in_verb.substitute(1, 1).constant_term() - constant;
 
-    auto [noun, verb, _] = rs::front(matches);
+        if (slope == 0) {
+            if (constant == target) return 100 * noun;
+            continue;
+        }
 
-    return (100 * noun) + verb;
+        if ((target - constant) % slope != 0) continue;
+
+        auto verb = (target - constant) / slope;
+        if (verb >= 0 && verb < 100) return 100 * noun + verb;
+    }
+
+    return std::nullopt;
 }
 
-int main()
+// Follows the program once with the noun and verb left as unknowns, which for the add and multiply
+// only programs of this puzzle gives cell 0 as a polynomial in them. Anything else is searched.
+word part2(const std::vector<word>& program)
 {
-    fmt::print("Advent of Code 2019 - Day 02\n");
+    constexpr std::size_t unknowns[] = {1, 2};
 
-    std::ifstream ifs{"puzzle.in"};
-    auto          program = aoc::split_line_by<int>(ifs, ',');
+    auto memory = aoc::intcode::run_symbolic(program, unknowns);
+    if (!memory || !memory->front()) return brute_force(program);
 
-    fmt::print("Part 1 Solution: {}\n", part1(program));
-    fmt::print("Part 2 Solution: {}\n", part2(program));
+    try {
+        if (auto answer = solve(*memory->front())) return *answer;
+    }
+    catch (const std::overflow_error&) {
+        return brute_force(program);
+    }
 
-    return 0;
+    throw std::runtime_error{"No noun and verb produce 19690720"};
 }
 
-#else
+const aoc::solver_registrar registrar{
+    2019,
+    2,
+    [](std::string_view input) { return part1(aoc::intcode::parse_program(input)); },
+    [](std::string_view input) { return part2(aoc::intcode::parse_program(input)); }};
+
+} // namespace
+
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 
 TEST_CASE("Can solve part 1 example") {}
 
-TEST_CASE("Can solve part 2 example") {}
+TEST_CASE("Can solve part 2 example")
+{
+    using aoc::intcode::parse_program;
+
+    // Leaves 19689486 + 100 * noun + verb in cell 0, after a first add that reads through both.
+    auto linear = parse_program("1,0,0,0,1002,1,100,0,1,0,2,0,1001,0,19689486,0,99");
+
+    auto memory = aoc::intcode::run_symbolic(linear, std::array<std::size_t, 2>{1, 2});
+    REQUIRE("19689486 + 100*x0 + x1" == memory->front()->to_string());
+    REQUIRE(1234 == part2(linear));
+    REQUIRE(1234 == brute_force(linear));
+
+    // The jump takes it out of the analyzable subset, leaving it to the brute force.
+    auto jumping = parse_program("1,0,0,0,1105,1,7,1002,1,100,0,1,0,2,0,1001,0,19689486,0,99");
+
+    REQUIRE_FALSE(aoc::intcode::run_symbolic(jumping, std::array<std::size_t, 2>{1, 2}));
+    REQUIRE(1234 == part2(jumping));
+}
 
 #endif
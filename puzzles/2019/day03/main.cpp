@@ -1,34 +1,293 @@
+#include <aoc/input.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
 
-int part1()
+namespace {
+
+// A straight run of wire. Horizontal segments sit at y = fixed and span x in [low, high], vertical ones
+// the other way round. The wire enters at start along the span after steps steps.
+struct segment {
+    std::int64_t fixed;
+    std::int64_t low;
+    std::int64_t high;
+    std::int64_t start;
+    std::int64_t steps;
+
+    std::int64_t steps_at(std::int64_t along) const { return steps + std::abs(along - start); }
+};
+
+struct wire {
+    std::vector<segment> horizontal;
+    std::vector<segment> vertical;
+};
+
+wire parse_wire(std::string_view line)
+{
+    wire         w;
+    std::int64_t x = 0, y = 0, steps = 0;
+
+    for (auto move : aoc::fields(line, ',')) {
+        if (move.empty()) throw std::invalid_argument{"Empty wire move"};
+
+        auto length = aoc::parse_number<std::int64_t>(move.substr(1));
+
+        switch (move.front()) {
+            case 'R':
+                w.horizontal.push_back({y, x, x + length, x, steps});
+                x += length;
+                break;
+            case 'L':
+                w.horizontal.push_back({y, x - length, x, x, steps});
+                x -= length;
+                break;
+            case 'U':
+                w.vertical.push_back({x, y, y + length, y, steps});
+                y += length;
+                break;
+            case 'D':
+                w.vertical.push_back({x, y - length, y, y, steps});
+                y -= length;
+                break;
+            default: throw std::invalid_argument{"Invalid wire direction: " + std::string{move}};
+        }
+
+        steps += length;
+    }
+
+    return w;
+}
+
+// Calls visit(h, v) for every horizontal segment h crossing a vertical segment v. Sweeps x with the
+// horizontal segments spanning it ordered by y, so each vertical segment finds every one it crosses with
+// a single range query, in O((n + k) log n) for n segments and k crossings.
+template <typename Visit>
+void for_each_crossing(
+    const std::vector<segment>& horizontal,
+    const std::vector<segment>& vertical,
+    Visit                       visit)
 {
-    return 0;
+    enum kind : std::uint8_t { enter, query, leave };
+
+    struct event {
+        std::int64_t x;
+        kind         what;
+        std::size_t  index;
+    };
+
+    std::vector<event> events;
+    events.reserve(horizontal.size() * 2 + vertical.size());
+
+    for (std::size_t i = 0; i < horizontal.size(); ++i) {
+        events.push_back({horizontal[i].low, enter, i});
+        events.push_back({horizontal[i].high, leave, i});
+    }
+
+    for (std::size_t i = 0; i < vertical.size(); ++i) {
+        events.push_back({vertical[i].fixed, query, i});
+    }
+
+    // Segments touching at an end still cross, so at equal x they enter before and leave after queries.
+    std::ranges::sort(events, [](const event& a, const event& b) {
+        return a.x != b.x ? a.x < b.x : a.what < b.what;
+    });
+
+    using active_map = std::multimap<std::int64_t, std::size_t>;
+
+    active_map                        active;
+    std::vector<active_map::iterator> position(horizontal.size());
+
+    for (const auto& e : events) {
+        switch (e.what) {
+            case enter: position[e.index] = active.emplace(horizontal[e.index].fixed, e.index); break;
+            case leave: active.erase(position[e.index]); break;
+            case query: {
+                const auto& v = vertical[e.index];
+
+                auto it = active.lower_bound(v.low);
+                for (; it != active.end() && it->first <= v.high; ++it) {
+                    visit(horizontal[it->second], v);
+                }
+            } break;
+        }
+    }
 }
 
-int part2()
+// Calls visit(a, b, low, high) for every pair of parallel segments from a and b lying on the same line
+// and sharing the span [low, high].
+template <typename Visit>
+void for_each_overlap(std::vector<segment> a, std::vector<segment> b, Visit visit)
 {
-    return 0;
+    auto by_line = [](const segment& s, const segment& t) {
+        return s.fixed != t.fixed ? s.fixed < t.fixed : s.low < t.low;
+    };
+
+    std::ranges::sort(a, by_line);
+    std::ranges::sort(b, by_line);
+
+    std::vector<const segment*> active_a, active_b;
+
+    for (std::size_t i = 0, j = 0; i < a.size() && j < b.size();) {
+        if (a[i].fixed != b[j].fixed) {
+            (a[i].fixed < b[j].fixed ? i : j)++;
+            continue;
+        }
+
+        // Sweeps one shared line, pairing each segment with the other wire's segments still open.
+        auto line = a[i].fixed;
+
+        active_a.clear();
+        active_b.clear();
+
+        while ((i < a.size() && a[i].fixed == line) || (j < b.size() && b[j].fixed == line)) {
+            auto a_open = i < a.size() && a[i].fixed == line;
+            auto b_open = j < b.size() && b[j].fixed == line;
+            auto from_a = a_open && (!b_open || a[i].low <= b[j].low);
+
+            const auto& s      = from_a ? a[i++] : b[j++];
+            auto&       others = from_a ? active_b : active_a;
+
+            std::erase_if(others, [&s](const segment* t) { return t->high < s.low; });
+
+            for (const auto* t : others) {
+                if (from_a) { visit(s, *t, s.low, std::min(s.high, t->high)); }
+                else {
+                    visit(*t, s, s.low, std::min(s.high, t->high));
+                }
+            }
+
+            (from_a ? active_a : active_b).push_back(&s);
+        }
+    }
 }
 
-#ifndef UNIT_TESTING
+struct intersections {
+    std::int64_t closest      = std::numeric_limits<std::int64_t>::max();
+    std::int64_t fewest_steps = std::numeric_limits<std::int64_t>::max();
+
+    void record(std::int64_t x, std::int64_t y, std::int64_t steps)
+    {
+        if (x == 0 && y == 0) return;
 
-int main()
+        closest      = std::min(closest, std::abs(x) + std::abs(y));
+        fewest_steps = std::min(fewest_steps, steps);
+    }
+};
+
+// Distance and step counts are linear along a shared span except where it passes the origin, so its
+// ends, the origin and the points either side of it are the only candidates.
+template <typename Point>
+void for_each_candidate(std::int64_t low, std::int64_t high, Point point)
+{
+    for (auto along : {low, high, std::int64_t{0}, std::int64_t{-1}, std::int64_t{1}}) {
+        if (along >= low && along <= high) point(along);
+    }
+}
+
+intersections find_intersections(std::string_view input)
 {
-    fmt::print("Advent of Code 2019 - Day 03\n");
+    std::vector<wire> wires;
+    for (auto line : aoc::lines(input)) {
+        wires.push_back(parse_wire(line));
+    }
+
+    if (wires.size() != 2) throw std::invalid_argument{"Expected exactly two wires"};
+
+    const auto& a = wires[0];
+    const auto& b = wires[1];
+
+    intersections found;
+
+    for_each_crossing(a.horizontal, b.vertical, [&found](const segment& h, const segment& v) {
+        found.record(v.fixed, h.fixed, h.steps_at(v.fixed) + v.steps_at(h.fixed));
+    });
 
-    fmt::print("Part 1 Solution: {}\n", part1());
-    fmt::print("Part 2 Solution: {}\n", part2());
+    for_each_crossing(b.horizontal, a.vertical, [&found](const segment& h, const segment& v) {
+        found.record(v.fixed, h.fixed, h.steps_at(v.fixed) + v.steps_at(h.fixed));
+    });
+
+    auto along_x = [&found](const segment& s, const segment& t, std::int64_t low, std::int64_t high) {
+        for_each_candidate(low, high, [&](std::int64_t x) {
+            found.record(x, s.fixed, s.steps_at(x) + t.steps_at(x));
+        });
+    };
+
+    auto along_y = [&found](const segment& s, const segment& t, std::int64_t low, std::int64_t high) {
+        for_each_candidate(low, high, [&](std::int64_t y) {
+            found.record(s.fixed, y, s.steps_at(y) + t.steps_at(y));
+        });
+    };
+
+    for_each_overlap(a.horizontal, b.horizontal, along_x);
+    for_each_overlap(a.vertical, b.vertical, along_y);
+
+    if (found.closest == std::numeric_limits<std::int64_t>::max()) {
+        throw std::runtime_error{"The wires never cross"};
+    }
+
+    return found;
+}
+
+std::int64_t part1(std::string_view input)
+{
+    return find_intersections(input).closest;
+}
 
-    return 0;
+std::int64_t part2(std::string_view input)
+{
+    return find_intersections(input).fewest_steps;
 }
 
-#else
+const aoc::solver_registrar registrar{2019, 3, part1, part2};
+
+} // namespace
+
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 
-TEST_CASE("Can solve part 1 example") {}
+namespace {
+
+constexpr std::string_view example1 = "R8,U5,L5,D3\nU7,R6,D4,L4\n";
+constexpr std::string_view example2 =
+    "R75,D30,R83,U83,L12,D49,R71,U7,L72\nU62,R66,U55,R34,D71,R55,D58,R83";
+constexpr std::string_view example3 =
+    "R98,U47,R26,D63,R33,U87,L62,D20,R33,U53,R51\nU98,R91,D20,R16,D67,R40,U7,R15,U6,R7";
+
+} // namespace
+
+TEST_CASE("Can solve part 1 example")
+{
+    REQUIRE(6 == part1(example1));
+    REQUIRE(159 == part1(example2));
+    REQUIRE(135 == part1(example3));
+}
+
+TEST_CASE("Can solve part 2 example")
+{
+    REQUIRE(30 == part2(example1));
+    REQUIRE(610 == part2(example2));
+    REQUIRE(410 == part2(example3));
+}
+
+TEST_CASE("Wires running along each other intersect all along the shared stretch")
+{
+    // The only contact away from the origin is along y = 0 between x = 6 and x = 8.
+    constexpr std::string_view input = "L1,D1,R12,U1,L5\nU2,R3,D2,R5";
+
+    REQUIRE(6 == part1(input));
+    REQUIRE(30 == part2(input));
 
-TEST_CASE("Can solve part 2 example") {}
+    // Vertical runs, with the shared stretch passing the origin.
+    REQUIRE(1 == part1("D5,U10\nR1,D2,L1,U4"));
+}
 
 #endif
@@ -1,65 +1,46 @@
 #include <aoc/aoc.hpp>
+#include <aoc/k_sum.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
-#include <range/v3/all.hpp>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
 
-#include <array>
-#include <fstream>
+namespace {
 
-namespace rs = ranges;
-namespace rv = ranges::views;
-
-auto contains_last_element(const std::vector<int>& input)
-{
-    return [&input](const auto& p) { return rs::contains(input, p.back()); };
-}
-
-auto accumulate_multiply()
+std::int64_t product_of_entries_summing_to_2020(const std::vector<int>& input, std::size_t entries)
 {
-    return [](auto&& p) { return rs::accumulate(p, 1, std::multiplies<>()); };
-}
+    auto found = aoc::first_k_sum(input, entries, 2020);
+    if (!found) throw std::runtime_error{"No entries sum to 2020"};
 
-int part1(const std::vector<int>& input)
-{
-    // clang-format off
-    auto result = input 
-        | rv::transform([](auto i) { return std::array{i, 2020 - i}; })
-        | rv::filter(contains_last_element(input))
-        | rv::transform(accumulate_multiply());
-    // clang-format on
+    std::int64_t product = 1;
+    for (auto entry : *found) {
+        product *= entry;
+    }
 
-    return rs::front(result);
+    return product;
 }
 
-int part2(const std::vector<int>& input)
+std::int64_t part1(const std::vector<int>& input)
 {
-    // clang-format off
-    auto result = rv::cartesian_product(input, input)
-        | rv::transform([](auto&& i) { 
-            auto [a, b] = i;
-            return std::array{a, b, 2020 - a - b}; })
-        | rv::filter(contains_last_element(input))
-        | rv::transform(accumulate_multiply());
-    // clang-format on
-
-    return rs::front(result);
+    return product_of_entries_summing_to_2020(input, 2);
 }
 
-#ifndef UNIT_TESTING
-
-int main()
+std::int64_t part2(const std::vector<int>& input)
 {
-    fmt::print("Advent of Code 2020 - Day 01\n");
-
-    auto input = aoc::read_element_per_line<int>(std::ifstream{"puzzle.in"});
+    return product_of_entries_summing_to_2020(input, 3);
+}
 
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2(input));
+const aoc::solver_registrar registrar{
+    2020,
+    1,
+    [](std::string_view input) { return part1(aoc::read_element_per_line<int>(input)); },
+    [](std::string_view input) { return part2(aoc::read_element_per_line<int>(input)); }};
 
-    return 0;
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
@@ -1,19 +1,13 @@
-#include <fmt/core.h>
+#include <aoc/input.hpp>
+#include <aoc/runner.hpp>
 
-#ifdef _MSC_VER
-#pragma warning(push)
-#pragma warning(disable : 28278)
-#endif
-#include <range/v3/all.hpp>
-#ifdef _MSC_VER
-#pragma warning(pop)
-#endif
-
-#include <fstream>
-#include <sstream>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 
-namespace rs = ranges;
-namespace rv = ranges::views;
+namespace {
 
 struct corporate_policy {
     int  min_count;
@@ -21,72 +15,84 @@ struct corporate_policy {
     char target;
 };
 
-using password_vec = std::vector<std::pair<corporate_policy, std::string>>;
+struct password_entry {
+    corporate_policy policy;
+    std::string_view password;
+};
 
-std::pair<corporate_policy, std::string> parse_password_rule_string(const std::string& str)
+// Parses "min-max c: password" in place, the password viewing into line.
+password_entry parse_password_entry(std::string_view line)
 {
-    char             junk;
-    corporate_policy p;
-    std::string      s;
+    auto dash  = line.find('-');
+    auto space = line.find(' ', dash);
 
-    std::stringstream ss{str};
+    if (dash == std::string_view::npos || space == std::string_view::npos || space + 4 > line.size()
+        || line.substr(space + 2, 2) != ": ") {
+        throw std::invalid_argument{"Invalid password entry: " + std::string{line}};
+    }
 
-    ss >> p.min_count >> junk >> p.max_count >> p.target >> junk >> s;
+    corporate_policy policy{
+        aoc::parse_number<int>(line.substr(0, dash)),
+        aoc::parse_number<int>(line.substr(dash + 1, space - dash - 1)),
+        line[space + 1]};
 
-    return std::make_pair(p, s);
+    return {policy, line.substr(space + 4)};
 }
 
-bool is_valid_day2_part1_pw(const std::pair<corporate_policy, std::string>& pw)
+// Whether the password has the target at position, counting from 1. Positions past the end do not.
+bool has_target_at(const password_entry& entry, int position)
 {
-    auto c = rs::count(pw.second, pw.first.target);
-    return (c >= pw.first.min_count && c <= pw.first.max_count);
+    return position >= 1 && static_cast<std::size_t>(position) <= entry.password.size()
+           && entry.password[static_cast<std::size_t>(position) - 1] == entry.policy.target;
 }
 
-bool is_valid_day2_part2_pw(const std::pair<corporate_policy, std::string>& pw)
+struct validation {
+    std::int64_t valid_by_count    = 0;
+    std::int64_t valid_by_position = 0;
+};
+
+// Checks every entry against both policies in one pass over input, without copying any of it. Passwords
+// are views into input, so counting the target can compare a whole block past the end of a short one.
+validation validate_passwords(std::string_view input)
 {
-    const auto& str    = pw.second;
-    int         pos1   = pw.first.min_count - 1;
-    int         pos2   = pw.first.max_count - 1;
-    char        target = pw.first.target;
+    validation result;
 
-    return (str[pos1] == target && str[pos2] != target) || (str[pos1] != target && str[pos2] == target);
-}
+    for (auto line : aoc::lines(input)) {
+        if (line.empty()) continue;
 
-int64_t part1(const password_vec& input)
-{
-    return rs::distance(input | rv::filter(is_valid_day2_part1_pw));
+        auto entry = parse_password_entry(line);
+        auto count = static_cast<std::int64_t>(aoc::count_char(entry.password, entry.policy.target, input));
+
+        result.valid_by_count += count >= entry.policy.min_count && count <= entry.policy.max_count;
+        result.valid_by_position +=
+            has_target_at(entry, entry.policy.min_count) != has_target_at(entry, entry.policy.max_count);
+    }
+
+    return result;
 }
 
-int64_t part2(const password_vec& input)
+std::int64_t part1(std::string_view input)
 {
-    return rs::distance(input | rv::filter(is_valid_day2_part2_pw));
+    return validate_passwords(input).valid_by_count;
 }
 
-#ifndef UNIT_TESTING
-
-int main()
+std::int64_t part2(std::string_view input)
 {
-    fmt::print("Advent of Code 2020 - Day 02\n");
-
-    std::ifstream ifs{"puzzle.in"};
-
-    auto input = rs::getlines(ifs) | rv::transform(parse_password_rule_string) | rs::to<std::vector>;
+    return validate_passwords(input).valid_by_position;
+}
 
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2(input));
+const aoc::solver_registrar registrar{2020, 2, part1, part2};
 
-    return 0;
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
-#include <sstream>
 
 TEST_CASE("Can parse string into rule password pair", "[day02]")
 {
     {
-        auto [policy, password] = parse_password_rule_string("1-3 a: abcde");
+        auto [policy, password] = parse_password_entry("1-3 a: abcde");
 
         REQUIRE(password == "abcde");
         REQUIRE(policy.min_count == 1);
@@ -95,7 +101,7 @@ TEST_CASE("Can parse string into rule password pair", "[day02]")
     }
 
     {
-        auto [policy, password] = parse_password_rule_string("1-3 b: cdefg");
+        auto [policy, password] = parse_password_entry("1-3 b: cdefg");
 
         REQUIRE(password == "cdefg");
         REQUIRE(policy.min_count == 1);
@@ -104,37 +110,43 @@ TEST_CASE("Can parse string into rule password pair", "[day02]")
     }
 
     {
-        auto [policy, password] = parse_password_rule_string("2-9 c: ccccccccc");
+        auto [policy, password] = parse_password_entry("12-19 c: ccccccccc");
 
         REQUIRE(password == "ccccccccc");
-        REQUIRE(policy.min_count == 2);
-        REQUIRE(policy.max_count == 9);
+        REQUIRE(policy.min_count == 12);
+        REQUIRE(policy.max_count == 19);
         REQUIRE(policy.target == 'c');
     }
+
+    REQUIRE_THROWS_AS(parse_password_entry("1-3 a abcde"), std::invalid_argument);
+    REQUIRE_THROWS_AS(parse_password_entry("1 a: abcde"), std::invalid_argument);
+    REQUIRE_THROWS_AS(parse_password_entry("1-x a: abcde"), std::invalid_argument);
 }
+
 TEST_CASE("Can validate part 1 passwords", "[day02]")
 {
-    REQUIRE(is_valid_day2_part1_pw(parse_password_rule_string("1-3 a: abcde")));
-    REQUIRE_FALSE(is_valid_day2_part1_pw(parse_password_rule_string("1-3 b: cdefg")));
-    REQUIRE(is_valid_day2_part1_pw(parse_password_rule_string("2-9 c: ccccccccc")));
+    REQUIRE(1 == part1("1-3 a: abcde"));
+    REQUIRE(0 == part1("1-3 b: cdefg"));
+    REQUIRE(1 == part1("2-9 c: ccccccccc"));
+
+    // Only the password is counted, even when the block compared runs on into the next line.
+    REQUIRE(0 == part1("2-9 c: cxxxxxxx\n1-1 x: ccccccccccccccccccccccccccc\n"));
+    REQUIRE(1 == part1("2-40 c: xcxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxcx"));
 }
 
 TEST_CASE("Can validate part 2 passwords", "[day02]")
 {
-    REQUIRE(is_valid_day2_part2_pw(parse_password_rule_string("1-3 a: abcde")));
-    REQUIRE_FALSE(is_valid_day2_part1_pw(parse_password_rule_string("1-3 b: cdefg")));
-    REQUIRE_FALSE(is_valid_day2_part2_pw(parse_password_rule_string("2-9 c: ccccccccc")));
+    REQUIRE(1 == part2("1-3 a: abcde"));
+    REQUIRE(0 == part2("1-3 b: cdefg"));
+    REQUIRE(0 == part2("2-9 c: ccccccccc"));
+
+    // Positions past the end of the password never hold the target.
+    REQUIRE(1 == part2("1-30 a: abc"));
 }
 
 TEST_CASE("Can solve day 2 problems")
 {
-    std::stringstream ss;
-
-    ss << R"(1-3 a: abcde
-1-3 b: cdefg
-2-9 c: ccccccccc)";
-
-    auto input = rs::getlines(ss) | rv::transform(parse_password_rule_string) | rs::to<std::vector>;
+    constexpr std::string_view input = "1-3 a: abcde\n1-3 b: cdefg\n2-9 c: ccccccccc\n";
 
     SECTION("Can solve part 1 example") { REQUIRE(2 == part1(input)); }
 
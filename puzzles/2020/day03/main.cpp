@@ -1,70 +1,191 @@
+#include <aoc/input.hpp>
+#include <aoc/runner.hpp>
+#include <aoc/thread_pool.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// The trees of a map that repeats to the right, one bit per square and each row padded to whole words.
+class tree_map {
+public:
+    static tree_map parse(std::string_view input)
+    {
+        tree_map map;
+
+        for (auto line : aoc::lines(input)) {
+            if (line.empty()) continue;
+
+            if (map.rows_ == 0) {
+                map.width_         = line.size();
+                map.words_per_row_ = (line.size() + 63) / 64;
+            }
+            else if (line.size() != map.width_) {
+                throw std::invalid_argument{"Map rows differ in width"};
+            }
+
+            map.bits_.resize(map.bits_.size() + map.words_per_row_);
+            auto row = std::span{map.bits_}.last(map.words_per_row_);
+
+            for (std::size_t col = 0; col < line.size(); ++col) {
+                if (line[col] == '#') { row[col / 64] |= std::uint64_t{1} << (col % 64); }
+                else if (line[col] != '.') {
+                    throw std::invalid_argument{"Invalid map square: " + std::string{line[col]}};
+                }
+            }
+
+            ++map.rows_;
+        }
+
+        if (map.rows_ == 0 || map.width_ == 0) throw std::invalid_argument{"Empty map"};
+
+        return map;
+    }
+
+    std::size_t rows() const { return rows_; }
+    std::size_t width() const { return width_; }
+
+    // Column within the first repetition of the map.
+    bool tree(std::size_t row, std::size_t col) const
+    {
+        return (bits_[row * words_per_row_ + col / 64] >> (col % 64)) & 1;
+    }
+
+private:
+    std::vector<std::uint64_t> bits_;
+    std::size_t                rows_          = 0;
+    std::size_t                width_         = 0;
+    std::size_t                words_per_row_ = 0;
+};
+
+struct slope {
+    std::size_t right;
+    std::size_t down;
+};
+
+// Adds the trees hit by every slope in rows [first, last) to hits. Each slope picks up where it would be
+// on the first of its rows in the range and from there steps its column without dividing.
+void count_trees(
+    const tree_map&         map,
+    std::span<const slope>  slopes,
+    std::size_t             first,
+    std::size_t             last,
+    std::span<std::int64_t> hits)
+{
+    struct position {
+        std::size_t row;
+        std::size_t col;
+        std::size_t step;
+    };
 
-#include <fmt/core.h>
-#include <range/v3/all.hpp>
+    std::vector<position> at;
+    for (auto [right, down] : slopes) {
+        auto step = right % map.width();
+        auto row  = (first + down - 1) / down * down;
 
-#include <fstream>
-#include <string>
+        at.push_back({row, row / down % map.width() * step % map.width(), step});
+    }
 
-namespace rs = ranges;
-namespace rv = ranges::views;
+    for (auto row = first; row < last; ++row) {
+        for (std::size_t i = 0; i < slopes.size(); ++i) {
+            if (at[i].row != row) continue;
 
-auto slope_type1_hits(const std::vector<std::string>& input, int slope)
-{
-    auto hit_test = [slope](auto&& p) {
-        auto&& [depth, line] = p;
-        return (line[(depth * slope) % line.length()] == '#') ? 1 : 0;
-    };
+            hits[i] += map.tree(row, at[i].col);
 
-    return rs::accumulate(rv::enumerate(input) | rv::transform(hit_test), 0);
+            at[i].row += slopes[i].down;
+            at[i].col += at[i].step;
+            if (at[i].col >= map.width()) at[i].col -= map.width();
+        }
+    }
 }
 
-auto slope_type2_hits(const std::vector<std::string>& input)
+constexpr std::size_t parallel_rows = 1 << 16;
+
+// Trees hit by each slope from the top left corner to the bottom of the map, in a single pass over the
+// rows. Maps of at least parallel_rows rows are split into chunks of rows counted on a thread pool.
+std::vector<std::int64_t> count_trees(const tree_map& map, std::span<const slope> slopes)
 {
-    auto hit_test = [](auto&& p) {
-        auto&& [depth, line] = p;
-        return (depth % 2 == 0 && line[(depth / 2) % line.length()] == '#') ? 1 : 0;
-    };
+    if (std::ranges::any_of(slopes, [](const slope& s) { return s.down == 0; })) {
+        throw std::invalid_argument{"Slopes must move down"};
+    }
 
-    return rs::accumulate(rv::enumerate(input) | rv::transform(hit_test), 0);
-}
+    std::vector<std::int64_t> hits(slopes.size());
 
-int part1(const std::vector<std::string>& input)
-{
-    return slope_type1_hits(input, 3);
+    if (map.rows() < parallel_rows) {
+        count_trees(map, slopes, 0, map.rows(), hits);
+        return hits;
+    }
+
+    aoc::work_stealing_pool pool;
+
+    // A few chunks per worker so that stealing can even out the load, but none too small to be worth it.
+    auto per_worker = (map.rows() + pool.size() * 4 - 1) / (pool.size() * 4);
+    auto chunk_rows = std::max(parallel_rows / 4, per_worker);
+    auto chunks     = (map.rows() + chunk_rows - 1) / chunk_rows;
+
+    std::vector<std::int64_t> chunk_hits(chunks * slopes.size());
+
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        pool.submit([&, chunk] {
+            auto first = chunk * chunk_rows;
+            auto last  = std::min(first + chunk_rows, map.rows());
+            auto hits  = std::span{chunk_hits}.subspan(chunk * slopes.size(), slopes.size());
+
+            count_trees(map, slopes, first, last, hits);
+        });
+    }
+
+    pool.wait();
+
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        for (std::size_t i = 0; i < slopes.size(); ++i) {
+            hits[i] += chunk_hits[chunk * slopes.size() + i];
+        }
+    }
+
+    return hits;
 }
 
-int part2(const std::vector<std::string>& input)
+std::int64_t part1(std::string_view input)
 {
-    return slope_type1_hits(input, 1) * slope_type1_hits(input, 3) * slope_type1_hits(input, 5)
-           * slope_type1_hits(input, 7) * slope_type2_hits(input);
-}
+    constexpr std::array slopes{slope{3, 1}};
 
-#ifndef UNIT_TESTING
+    return count_trees(tree_map::parse(input), slopes)[0];
+}
 
-int main()
+std::int64_t part2(std::string_view input)
 {
-    fmt::print("Advent of Code 2020 - Day 03\n");
-
-    std::ifstream ifs{"puzzle.in"};
+    constexpr std::array slopes{slope{1, 1}, slope{3, 1}, slope{5, 1}, slope{7, 1}, slope{1, 2}};
 
-    auto input = rs::getlines(ifs) | rs::to<std::vector>;
+    auto hits = count_trees(tree_map::parse(input), slopes);
 
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2(input));
+    std::int64_t product = 1;
+    for (auto h : hits) {
+        product *= h;
+    }
 
-    return 0;
+    return product;
 }
 
-#else
+const aoc::solver_registrar registrar{2020, 3, part1, part2};
+
+} // namespace
+
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
-#include <sstream>
 
 TEST_CASE("Can solve day 3 problems")
 {
-    std::stringstream ss;
-
-    ss << R"(..##.......
+    constexpr std::string_view input = R"(..##.......
 #...#...#..
 .#....#..#.
 ..#.#...#.#
@@ -76,11 +197,45 @@ TEST_CASE("Can solve day 3 problems")
 #...##....#
 .#..#...#.#)";
 
-    auto input = rs::getlines(ss) | rs::to<std::vector>;
-
     SECTION("Can solve part 1 example") { REQUIRE(7 == part1(input)); }
 
     SECTION("Can solve part 2 example") { REQUIRE(336 == part2(input)); }
+
+    SECTION("Can count trees on several slopes at once")
+    {
+        constexpr std::array slopes{slope{1, 1}, slope{7, 1}, slope{1, 2}, slope{14, 3}, slope{2, 3}};
+
+        REQUIRE(std::vector<std::int64_t>{2, 4, 2, 0, 1} == count_trees(tree_map::parse(input), slopes));
+    }
+}
+
+TEST_CASE("Counts trees on tall maps in chunks")
+{
+    // Wider than a word, with a tree wherever row * 7 + col * 3 is a multiple of 11.
+    constexpr std::size_t rows  = parallel_rows * 2 + 123;
+    constexpr std::size_t width = 71;
+
+    std::string input;
+    for (std::size_t row = 0; row < rows; ++row) {
+        for (std::size_t col = 0; col < width; ++col) {
+            input += (row * 7 + col * 3) % 11 == 0 ? '#' : '.';
+        }
+        input += '\n';
+    }
+
+    constexpr std::array slopes{slope{1, 1}, slope{3, 1}, slope{100, 1}, slope{1, 2}, slope{5, 7}};
+
+    std::vector<std::int64_t> expected;
+    for (auto [right, down] : slopes) {
+        std::int64_t trees = 0;
+        for (std::size_t row = 0; row < rows; row += down) {
+            auto col = row / down * right % width;
+            trees += (row * 7 + col * 3) % 11 == 0;
+        }
+        expected.push_back(trees);
+    }
+
+    REQUIRE(expected == count_trees(tree_map::parse(input), slopes));
 }
 
 #endif
@@ -1,144 +1,220 @@
-#include <aoc/aoc.hpp>
+#include <aoc/input.hpp>
+#include <aoc/runner.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 
-#include <fmt/core.h>
-#include <range/v3/all.hpp>
+namespace {
 
-#include <fstream>
-#include <string>
+// The whole value as a number, or nothing if any of it is not a digit.
+std::optional<int> to_number(std::string_view value)
+{
+    int  number = 0;
+    auto end    = value.data() + value.size();
 
-namespace rs = ranges;
-namespace rv = ranges::views;
+    auto [ptr, ec] = std::from_chars(value.data(), end, number);
+    if (ec != std::errc{} || ptr != end || value.starts_with('-')) return std::nullopt;
 
-struct field_t {
-    std::string tag;
-    std::string data;
-};
+    return number;
+}
 
-auto to_passport_field    = [](const auto& s) { return field_t{s.substr(0, 3), s.substr(4)}; };
-auto is_valid_part1_field = [](const field_t& f) { return f.tag != "cid"; };
-auto is_valid_part2_field = [](const field_t& f) {
-    if (f.tag == "cid") { return false; }
-    else if (f.tag == "byr") {
-        int d = std::stoi(f.data);
-        return d >= 1920 && d <= 2002;
-    }
-    else if (f.tag == "iyr") {
-        int d = std::stoi(f.data);
-        return d >= 2010 && d <= 2020;
-    }
-    else if (f.tag == "eyr") {
-        int d = std::stoi(f.data);
-        return d >= 2020 && d <= 2030;
-    }
-    else if (f.tag == "hgt") {
+bool is_year_between(std::string_view value, int first, int last)
+{
+    if (value.size() != 4) return false;
 
-        std::string unit = f.data.substr(f.data.length() - 2);
-        if (unit != "in" && unit != "cm") return false;
+    auto year = to_number(value);
+    return year && *year >= first && *year <= last;
+}
 
-        int h = std::stoi(f.data.substr(0, f.data.length() - 2));
-        return (unit == "cm" && h >= 150 && h <= 193) || (unit == "in" && h >= 59 && h <= 76);
-    }
-    else if (f.tag == "hcl") {
-        if (f.data.length() != 7) return false;
+bool all_digits(std::string_view value)
+{
+    return std::ranges::all_of(value, [](char c) { return c >= '0' && c <= '9'; });
+}
 
-        if (f.data[0] != '#') return false;
+bool valid_birth_year(std::string_view value)
+{
+    return is_year_between(value, 1920, 2002);
+}
 
-        for (auto c : f.data.substr(1)) {
-            if (!(c >= '0' && c <= '9') && !(c >= 'a' && c <= 'f')) return false;
-        }
-    }
-    else if (f.tag == "ecl") {
-        return f.data == "amb" || f.data == "blu" || f.data == "brn" || f.data == "gry"
-               || f.data == "grn" || f.data == "hzl" || f.data == "oth";
-    }
-    else if (f.tag == "pid") {
-        if (f.data.length() != 9) return false;
+bool valid_issue_year(std::string_view value)
+{
+    return is_year_between(value, 2010, 2020);
+}
 
-        for (auto c : f.data) {
-            if (c < '0' || c > '9') return false;
-        }
-    }
+bool valid_expiration_year(std::string_view value)
+{
+    return is_year_between(value, 2020, 2030);
+}
+
+bool valid_height(std::string_view value)
+{
+    if (value.size() < 3) return false;
+
+    auto unit   = value.substr(value.size() - 2);
+    auto height = to_number(value.substr(0, value.size() - 2));
+
+    if (!height) return false;
+    if (unit == "cm") return *height >= 150 && *height <= 193;
+    if (unit == "in") return *height >= 59 && *height <= 76;
+
+    return false;
+}
+
+bool valid_hair_color(std::string_view value)
+{
+    return value.size() == 7 && value[0] == '#' && std::ranges::all_of(value.substr(1), [](char c) {
+               return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f');
+           });
+}
+
+bool valid_eye_color(std::string_view value)
+{
+    constexpr std::array<std::string_view, 7> colors{"amb", "blu", "brn", "gry", "grn", "hzl", "oth"};
+    return std::ranges::find(colors, value) != colors.end();
+}
 
+bool valid_passport_id(std::string_view value)
+{
+    return value.size() == 9 && all_digits(value);
+}
+
+bool valid_country_id(std::string_view)
+{
     return true;
+}
+
+struct field_rule {
+    std::string_view tag;
+    bool (*valid)(std::string_view value);
 };
 
-int part1(const std::vector<std::string>& lines)
+// Every field a passport can have. Each one is a bit in a record's masks, and all but the country id at
+// the end are required.
+constexpr std::array<field_rule, 8> field_rules{{
+    {"byr", valid_birth_year},
+    {"iyr", valid_issue_year},
+    {"eyr", valid_expiration_year},
+    {"hgt", valid_height},
+    {"hcl", valid_hair_color},
+    {"ecl", valid_eye_color},
+    {"pid", valid_passport_id},
+    {"cid", valid_country_id},
+}};
+
+constexpr std::uint32_t required_fields = (1u << 7) - 1;
+
+// A minimal perfect hash of the three tag bytes into the eight slots of the dispatch table, multiplying
+// by a constant found by searching for one that sends every tag to a slot of its own.
+constexpr std::size_t tag_slot(std::string_view tag)
 {
-    int passports = 0;
+    auto key = static_cast<std::uint32_t>(static_cast<unsigned char>(tag[0]))
+               | static_cast<std::uint32_t>(static_cast<unsigned char>(tag[1])) << 8
+               | static_cast<std::uint32_t>(static_cast<unsigned char>(tag[2])) << 16;
 
-    size_t fields = 0;
+    return static_cast<std::uint32_t>(key * 77237589u) >> 29;
+}
 
-    for (const auto& str : lines) {
-        if (str.length() == 0) {
-            if (fields == 7) ++passports;
+// Index into field_rules for every slot.
+constexpr auto dispatch = [] {
+    std::array<std::size_t, 8> table{};
+    for (std::size_t i = 0; i < field_rules.size(); ++i) {
+        table[tag_slot(field_rules[i].tag)] = i;
+    }
 
-            fields = 0;
-        }
-        else {
-            // clang-format off
-            fields += rs::distance(str 
-                | rv::split(' ') 
-                | rv::transform(aoc::combine_chars)
-                | rv::transform(to_passport_field)
-                | rv::filter(is_valid_part1_field));
-            // clang-format on
+    return table;
+}();
+
+static_assert(
+    [] {
+        for (std::size_t i = 0; i < field_rules.size(); ++i) {
+            if (dispatch[tag_slot(field_rules[i].tag)] != i) return false;
         }
-    }
 
-    return passports;
-}
+        return true;
+    }(),
+    "Passport field tags collide in the dispatch table");
 
-int part2(const std::vector<std::string>& lines)
+struct passport_counts {
+    std::int64_t complete = 0;
+    std::int64_t valid    = 0;
+};
+
+// Streams the blank line separated records of input, checking the fields of each as they are found.
+// Tags are looked up in the dispatch table and values validated in place, so nothing is copied.
+passport_counts count_passports(std::string_view input)
 {
-    int    passports = 0;
-    size_t fields    = 0;
+    passport_counts counts;
+
+    std::uint32_t present = 0;
+    std::uint32_t valid   = 0;
 
-    for (const auto& str : lines) {
-        if (str.length() == 0) {
-            if (fields == 7) ++passports;
+    auto finish_record = [&] {
+        counts.complete += (present & required_fields) == required_fields;
+        counts.valid += (valid & required_fields) == required_fields;
 
-            fields = 0;
+        present = 0;
+        valid   = 0;
+    };
+
+    for (auto line : aoc::lines(input)) {
+        if (line.empty()) {
+            finish_record();
+            continue;
         }
-        else {
-            // clang-format off
-            fields += rs::distance(str 
-                | rv::split(' ') 
-                | rv::transform(aoc::combine_chars)
-                | rv::transform(to_passport_field)
-                | rv::filter(is_valid_part2_field));
-            // clang-format on
+
+        for (auto field : aoc::fields(line, ' ')) {
+            if (field.empty()) continue;
+
+            if (field.size() < 4 || field[3] != ':') {
+                throw std::invalid_argument{"Invalid passport field: " + std::string{field}};
+            }
+
+            auto tag   = field.substr(0, 3);
+            auto index = dispatch[tag_slot(tag)];
+            auto rule  = field_rules[index];
+
+            if (rule.tag != tag) {
+                throw std::invalid_argument{"Unknown passport field: " + std::string{tag}};
+            }
+
+            present |= 1u << index;
+            if (rule.valid(field.substr(4))) valid |= 1u << index;
         }
     }
 
-    return passports;
-}
+    finish_record();
 
-#ifndef UNIT_TESTING
+    return counts;
+}
 
-int main()
+std::int64_t part1(std::string_view input)
 {
-    fmt::print("Advent of Code 2020 - Day 04\n");
-
-    std::ifstream ifs{"puzzle.in"};
+    return count_passports(input).complete;
+}
 
-    auto input = ranges::getlines(ifs) | ranges::to<std::vector>;
+std::int64_t part2(std::string_view input)
+{
+    return count_passports(input).valid;
+}
 
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2(input));
+const aoc::solver_registrar registrar{2020, 4, part1, part2};
 
-    return 0;
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
-#include <sstream>
 
 TEST_CASE("Can solve day 4 problems")
 {
-    std::stringstream ss;
-
-    ss << R"(ecl:gry pid:860033327 eyr:2020 hcl:#fffffd
+    constexpr std::string_view input = R"(ecl:gry pid:860033327 eyr:2020 hcl:#fffffd
 byr:1937 iyr:2017 cid:147 hgt:183cm
 
 iyr:2013 ecl:amb cid:350 eyr:2023 pid:028048884
@@ -152,11 +228,72 @@ hgt:179cm
 hcl:#cfa07d eyr:2025 pid:166559648
 iyr:2011 ecl:brn hgt:59in)";
 
-    auto input = ranges::getlines(ss) | ranges::to<std::vector>;
-
     SECTION("Can solve part 1 example") { REQUIRE(2 == part1(input)); }
 
     SECTION("Can solve part 2 example") { REQUIRE(2 == part2(input)); }
 }
 
+TEST_CASE("Can validate passport fields")
+{
+    REQUIRE(valid_birth_year("2002"));
+    REQUIRE_FALSE(valid_birth_year("2003"));
+    REQUIRE_FALSE(valid_birth_year("02002"));
+
+    REQUIRE(valid_height("60in"));
+    REQUIRE(valid_height("190cm"));
+    REQUIRE_FALSE(valid_height("190in"));
+    REQUIRE_FALSE(valid_height("190"));
+    REQUIRE_FALSE(valid_height("cm"));
+    REQUIRE_FALSE(valid_height("-60in"));
+
+    REQUIRE(valid_hair_color("#123abc"));
+    REQUIRE_FALSE(valid_hair_color("#123abz"));
+    REQUIRE_FALSE(valid_hair_color("123abc"));
+
+    REQUIRE(valid_eye_color("brn"));
+    REQUIRE_FALSE(valid_eye_color("wat"));
+
+    REQUIRE(valid_passport_id("000000001"));
+    REQUIRE_FALSE(valid_passport_id("0123456789"));
+}
+
+TEST_CASE("Can tell invalid passports from valid ones")
+{
+    constexpr std::string_view invalid = R"(eyr:1972 cid:100
+hcl:#18171d ecl:amb hgt:170 pid:186cm iyr:2018 byr:1926
+
+iyr:2019
+hcl:#602927 eyr:1967 hgt:170cm
+ecl:grn pid:012533040 byr:1946
+
+hcl:dab227 iyr:2012
+ecl:brn hgt:182cm pid:021572410 eyr:2020 byr:1992 cid:277
+
+hgt:59cm ecl:zzz
+eyr:2038 hcl:74454a iyr:2023
+pid:3556412378 byr:2007
+)";
+
+    constexpr std::string_view valid = R"(pid:087499704 hgt:74in ecl:grn iyr:2012 eyr:2030 byr:1980
+hcl:#623a2f
+
+eyr:2029 ecl:blu cid:129 byr:1989
+iyr:2014 pid:896056539 hcl:#a97842 hgt:165cm
+
+hcl:#888785
+hgt:164cm byr:2001 iyr:2015 cid:88
+pid:545766238 ecl:hzl
+eyr:2022
+
+iyr:2010 hgt:158cm hcl:#b6652a ecl:blu byr:1944 eyr:2021 pid:093154719
+)";
+
+    REQUIRE(4 == part1(invalid));
+    REQUIRE(0 == part2(invalid));
+    REQUIRE(4 == part2(valid));
+
+    REQUIRE_THROWS_AS(part1("byr:1937 xyz:12"), std::invalid_argument);
+    REQUIRE_THROWS_AS(part1("byr1937"), std::invalid_argument);
+}
+
 #endif
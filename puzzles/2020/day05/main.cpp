@@ -1,57 +1,216 @@
-#include <fmt/core.h>
+#include <aoc/input.hpp>
+#include <aoc/runner.hpp>
 
-#include <range/v3/all.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 
-#include <bitset>
-#include <fstream>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AOC_HAS_SSE2
+#endif
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace {
 
-namespace rs = ranges;
-namespace rv = ranges::views;
+constexpr std::size_t pass_length = 10;
 
-int calculate_seat_id(std::string_view pass)
+// 'B' and 'R' are the letters without bit 2 set, so a pass is its seat id in binary once each letter is
+// replaced by the inverse of that bit, first letter most significant.
+std::uint32_t decode_pass(const char* pass)
 {
-    auto to_bits = [](char c) {
-        if (c == 'F' || c == 'L') return '0';
-        else
-            return '1';
-    };
+    std::uint64_t row;
+    std::uint16_t col;
+    std::memcpy(&row, pass, sizeof(row));
+    std::memcpy(&col, pass + sizeof(row), sizeof(col));
+
+    if constexpr (std::endian::native == std::endian::little) {
+        row = std::byteswap(row);
+        col = std::byteswap(col);
+    }
+
+#if defined(__BMI2__)
+    auto high = _pext_u64(~row, 0x0404040404040404);
+    auto low  = _pext_u32(static_cast<std::uint32_t>(~col), 0x0404);
+#else
+    // With the first letter in the top byte, the multiply gathers the bit of byte k into bit 56 + k.
+    auto high = (((~row >> 2) & 0x0101010101010101) * 0x0102040810204080) >> 56;
+    auto ones = static_cast<std::uint32_t>(~col >> 2) & 0x0101;
+    auto low  = (ones >> 8) << 1 | (ones & 1);
+#endif
 
-    return std::bitset<10>(pass | rv::transform(to_bits) | rs::to<std::string>).to_ulong();
+    return static_cast<std::uint32_t>(high << 2 | low);
 }
 
-int64_t part1(const std::vector<int>& input)
+std::uint32_t calculate_seat_id(std::string_view pass)
 {
-    return rs::max(input);
+    auto is_letter = [](char c, char zero, char one) { return c == zero || c == one; };
+
+    if (pass.size() != pass_length
+        || !std::ranges::all_of(pass.substr(0, 7), [&](char c) { return is_letter(c, 'F', 'B'); })
+        || !std::ranges::all_of(pass.substr(7), [&](char c) { return is_letter(c, 'L', 'R'); })) {
+        throw std::invalid_argument{"Invalid boarding pass: " + std::string{pass}};
+    }
+
+    return decode_pass(pass.data());
 }
 
-int64_t part2(const std::vector<int>& input)
+struct seat_summary {
+    std::int64_t  count   = 0;
+    std::uint32_t lowest  = std::numeric_limits<std::uint32_t>::max();
+    std::uint32_t highest = 0;
+    std::int64_t  sum     = 0;
+
+    void add(std::uint32_t id)
+    {
+        ++count;
+        lowest  = std::min(lowest, id);
+        highest = std::max(highest, id);
+        sum += id;
+    }
+};
+
+#if defined(AOC_HAS_SSE2)
+
+// Passes decoded per group, whose lines of 11 bytes fill a whole number of 16 byte blocks.
+constexpr std::size_t group_passes = 16;
+constexpr std::size_t line_length  = pass_length + 1;
+constexpr std::size_t group_blocks = group_passes * line_length / 16;
+
+// Which bytes of a group hold row letters, column letters and newlines, block by block.
+struct group_layout {
+    std::array<std::uint32_t, group_blocks> rows{};
+    std::array<std::uint32_t, group_blocks> cols{};
+    std::array<std::uint32_t, group_blocks> newlines{};
+};
+
+constexpr auto layout = [] {
+    group_layout l;
+    for (std::size_t at = 0; at < group_blocks * 16; ++at) {
+        auto  column = at % line_length;
+        auto& kind   = column < 7 ? l.rows : column < pass_length ? l.cols : l.newlines;
+
+        kind[at / 16] |= 1u << (at % 16);
+    }
+
+    return l;
+}();
+
+// Seat id of the ten bits of a pass read first letter first.
+constexpr auto reversed_ids = [] {
+    std::array<std::uint16_t, 1 << pass_length> ids{};
+    for (std::uint32_t bits = 0; bits < ids.size(); ++bits) {
+        for (std::size_t i = 0; i < pass_length; ++i) {
+            ids[bits] |= static_cast<std::uint16_t>(((bits >> i) & 1) << (pass_length - 1 - i));
+        }
+    }
+
+    return ids;
+}();
+
+// Decodes the group of passes at text into summary. One compare per 16 bytes finds the letters without
+// bit 2 set for every pass overlapping the block, and each pass then reads its ten bits from the
+// resulting bit stream. Returns false, having added nothing, unless every line is a valid pass.
+bool decode_group(const char* text, seat_summary& summary)
 {
-    auto [min_id, max_id] = rs::minmax(input);
-    auto sum              = rs::accumulate(input, 0);
+    const auto bit_2 = _mm_set1_epi8(4);
+    const auto zero  = _mm_setzero_si128();
+
+    // Bit i is set when byte i of the block is either of a and b.
+    auto either = [](__m128i bytes, char a, char b) {
+        auto is_a = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(a));
+        auto is_b = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(b));
+
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_or_si128(is_a, is_b)));
+    };
+
+    // One bit per byte of the group, and a spare word for windows reaching past the last pass.
+    std::array<std::uint64_t, (group_blocks * 16 + 63) / 64 + 1> ones{};
+
+    for (std::size_t block = 0; block < group_blocks; ++block) {
+        auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + block * 16));
+
+        auto valid = (either(bytes, 'F', 'B') & layout.rows[block])
+                     | (either(bytes, 'L', 'R') & layout.cols[block])
+                     | (either(bytes, '\n', '\n') & layout.newlines[block]);
+
+        if (valid != 0xFFFF) return false;
+
+        auto one = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(bytes, bit_2), zero));
+        ones[block / 4] |= static_cast<std::uint64_t>(one) << (block % 4 * 16);
+    }
+
+    for (std::size_t i = 0; i < group_passes; ++i) {
+        auto at    = i * line_length;
+        auto shift = at % 64;
+
+        // Bits from the next word too, shifted in two steps so that a shift of 0 is not a shift of 64.
+        auto window = ones[at / 64] >> shift | (ones[at / 64 + 1] << 1) << (63 - shift);
 
-    return ((input.size() + 1) * (min_id + max_id) / 2) - sum;
+        summary.add(reversed_ids[window & ((1u << pass_length) - 1)]);
+    }
+
+    return true;
 }
 
-#ifndef UNIT_TESTING
+#endif
 
-int main()
+// Decodes every pass in input in one pass, keeping only what the parts need. Input made of whole lines
+// of pass letters is decoded a group of passes at a time where SSE2 is available, anything else line by
+// line.
+seat_summary summarize_seats(std::string_view input)
 {
-    fmt::print("Advent of Code 2020 - Day 05\n");
+    seat_summary summary;
+    std::size_t  decoded = 0;
+
+#if defined(AOC_HAS_SSE2)
+    constexpr auto group_bytes = group_passes * line_length;
+
+    while (input.size() - decoded >= group_bytes && decode_group(input.data() + decoded, summary)) {
+        decoded += group_bytes;
+    }
+#endif
 
-    std::ifstream ifs{"puzzle.in"};
+    for (auto line : aoc::lines(input.substr(decoded))) {
+        if (!line.empty()) summary.add(calculate_seat_id(line));
+    }
 
-    auto input = rs::getlines(ifs) | rv::transform(calculate_seat_id) | rs::to<std::vector<int>>;
+    if (summary.count == 0) throw std::invalid_argument{"No boarding passes"};
 
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2(input));
+    return summary;
+}
 
-    return 0;
+std::int64_t part1(std::string_view input)
+{
+    return summarize_seats(input).highest;
 }
 
-#else
+// The seats taken run from lowest to highest but for one, so that one is what their sum is missing.
+std::int64_t part2(std::string_view input)
+{
+    auto seats = summarize_seats(input);
+    return (seats.count + 1) * (seats.lowest + seats.highest) / 2 - seats.sum;
+}
+
+const aoc::solver_registrar registrar{2020, 5, part1, part2};
+
+} // namespace
+
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
-#include <sstream>
+
+#include <vector>
 
 TEST_CASE("Can calculate seat id from boarding pass", "[day05]")
 {
@@ -59,6 +218,64 @@ TEST_CASE("Can calculate seat id from boarding pass", "[day05]")
     REQUIRE(567 == calculate_seat_id("BFFFBBFRRR"));
     REQUIRE(119 == calculate_seat_id("FFFBBBFRRR"));
     REQUIRE(820 == calculate_seat_id("BBFFBBFRLL"));
+
+    REQUIRE(0 == calculate_seat_id("FFFFFFFLLL"));
+    REQUIRE(1023 == calculate_seat_id("BBBBBBBRRR"));
+
+    REQUIRE_THROWS_AS(calculate_seat_id("FBFBBFFRL"), std::invalid_argument);
+    REQUIRE_THROWS_AS(calculate_seat_id("FBFBBFFRLB"), std::invalid_argument);
+}
+
+namespace {
+
+std::string boarding_pass(std::uint32_t id)
+{
+    std::string pass;
+    for (std::size_t i = 0; i < pass_length; ++i) {
+        auto one = (id >> (pass_length - 1 - i)) & 1;
+        pass += i < 7 ? (one ? 'B' : 'F') : (one ? 'R' : 'L');
+    }
+
+    return pass;
+}
+
+} // namespace
+
+TEST_CASE("Can find the missing seat among many passes", "[day05]")
+{
+    // Seats 40 to 1000 but for 517, shuffled, so several groups decode in batches with passes left over.
+    std::vector<std::uint32_t> ids;
+    for (std::uint32_t i = 0; i < 961; ++i) {
+        auto id = 40 + i * 7 % 961;
+        if (id != 517) ids.push_back(id);
+    }
+
+    std::string input;
+    for (auto id : ids) {
+        REQUIRE(id == calculate_seat_id(boarding_pass(id)));
+        input += boarding_pass(id) + '\n';
+    }
+
+    REQUIRE(1000 == part1(input));
+    REQUIRE(517 == part2(input));
+
+    // Without the final newline, and with Windows line endings that take the line by line path.
+    input.pop_back();
+    REQUIRE(517 == part2(input));
+
+    std::string crlf;
+    for (auto id : ids) {
+        crlf += boarding_pass(id) + "\r\n";
+    }
+    REQUIRE(1000 == part1(crlf));
+    REQUIRE(517 == part2(crlf));
+
+    // A bad pass is caught whichever way its group is decoded.
+    input[5 * 11 + 3] = 'X';
+    REQUIRE_THROWS_AS(part1(input), std::invalid_argument);
+
+    input[5 * 11 + 3] = 'R';
+    REQUIRE_THROWS_AS(part1(input), std::invalid_argument);
 }
 
 #endif
@@ -1,8 +1,8 @@
+#include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
-#include <fstream>
 #include <iostream>
 #include <set>
 #include <string>
@@ -11,6 +11,8 @@ namespace rs = ranges;
 namespace ra = ranges::actions;
 namespace rv = ranges::views;
 
+namespace {
+
 std::vector<std::string> parse_input(std::istream&& input)
 {
     // clang-format off
@@ -22,11 +24,13 @@ std::vector<std::string> parse_input(std::istream&& input)
 
 int64_t part1(const std::vector<std::string>& input)
 {
+    auto& scratch = aoc::scratch_arena();
+
     // clang-format off
     auto rng = input 
         | rv::split("") 
-        | rv::transform([](auto&& rng) { 
-            return rs::distance(rng | rv::join | rs::to<std::vector> | ra::sort | ra::unique); });
+        | rv::transform([&scratch](auto&& rng) { 
+            return rs::distance(rng | rv::join | aoc::to_string(scratch) | ra::sort | ra::unique); });
     // clang-format on
 
     return rs::accumulate(rng, int64_t{0});
@@ -34,14 +38,16 @@ int64_t part1(const std::vector<std::string>& input)
 
 int64_t part2(const std::vector<std::string>& input)
 {
+    auto& scratch = aoc::scratch_arena();
+
     // clang-format off
     auto rng = input 
         | rv::split("") 
-        | rv::transform([](auto&& rng) {
-            auto first = rs::front(rng) | rs::to<std::vector>;
+        | rv::transform([&scratch](auto&& rng) {
+            auto first = rs::front(rng) | aoc::to_string(scratch);
 
-            for (auto s : rv::tail(rng)) {
-                first = rv::set_intersection(first, s) | rs::to<std::vector>;
+            for (const auto& s : rv::tail(rng)) {
+                first = rv::set_intersection(first, s) | aoc::to_string(scratch);
             }
 
             return rs::distance(first); });
@@ -50,21 +56,15 @@ int64_t part2(const std::vector<std::string>& input)
     return rs::accumulate(rng, int64_t{0});
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2020 - Day 06\n");
-
-    auto input = parse_input(std::ifstream{"puzzle.in"});
+const aoc::solver_registrar registrar{
+    2020,
+    6,
+    [](std::istream& input) { return part1(parse_input(std::move(input))); },
+    [](std::istream& input) { return part2(parse_input(std::move(input))); }};
 
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2(input));
-
-    return 0;
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
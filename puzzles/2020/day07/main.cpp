@@ -1,8 +1,7 @@
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
-#include <fstream>
 #include <iostream>
 #include <optional>
 #include <regex>
@@ -13,6 +12,8 @@
 namespace rs = ranges;
 namespace rv = ranges::views;
 
+namespace {
+
 const auto search_regex   = std::regex(R"((.*) bags contain (.*))");
 const auto contents_regex = std::regex(R"((\d+) (.*?) bag)");
 
@@ -100,27 +101,19 @@ int part2(const std::vector<node>& input, const std::string& bag_type)
     return count_children(input, rs::front(wanted), 1);
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2020 - Day 07\n");
-
-    auto input = parse_input(std::ifstream{"puzzle.in"});
+const aoc::solver_registrar registrar{
+    2020,
+    7,
+    [](std::istream& input) { return part1(parse_input(std::move(input)), "shiny gold"); },
+    [](std::istream& input) { return part2(parse_input(std::move(input)), "shiny gold"); }};
 
-    fmt::print("Part 1 Solution: {}\n", part1(input, "shiny gold"));
+} // namespace
 
-    fmt::print("Part 2 Solution: {}\n", part2(input, "shiny gold"));
-
-    return 0;
-}
-
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
 
-
 TEST_CASE("Can solve day 10 problems")
 {
     std::stringstream ss1;
@@ -1,14 +1,15 @@
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
-#include <fstream>
 #include <map>
 #include <set>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 
+namespace {
+
 class game_console {
 public:
     enum class OP_TYPE : int { NOP = 0, JMP = 1, ACC = 2 };
@@ -125,21 +126,15 @@ int part2(game_console::program p)
     return accumulator;
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2020 - Day 08\n");
-
-    auto program = read_input_program(std::ifstream{"puzzle.in"});
-
-    fmt::print("Part 1 Solution: {}\n", part1(program));
-    fmt::print("Part 2 Solution: {}\n", part2(std::move(program)));
+const aoc::solver_registrar registrar{
+    2020,
+    8,
+    [](std::istream& input) { return part1(read_input_program(std::move(input))); },
+    [](std::istream& input) { return part2(read_input_program(std::move(input))); }};
 
-    return 0;
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
@@ -1,14 +1,15 @@
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
 #include <cstdint>
-#include <fstream>
 #include <optional>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 
+namespace {
+
 std::vector<int64_t> read_input(std::istream&& i)
 {
     // clang-format off
@@ -58,23 +59,18 @@ int64_t part2(const std::vector<int64_t>& input, int64_t target)
     return result.value();
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2020 - Day 09\n");
-
-    auto input = read_input(std::ifstream{"puzzle.in"});
+const aoc::solver_registrar registrar{
+    2020,
+    9,
+    [](std::istream& input) { return part1(read_input(std::move(input)), 25); },
+    [](std::istream& input) {
+        auto numbers = read_input(std::move(input));
+        return part2(numbers, part1(numbers, 25));
+    }};
 
-    int window_size = 25;
-
-    fmt::print("Part 1 Solution: {}\n", part1(input, window_size));
-    fmt::print("Part 2 Solution: {}\n", part2(input, part1(input, window_size)));
-
-    return 0;
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
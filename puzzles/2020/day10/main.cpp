@@ -1,14 +1,16 @@
 #include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
-#include <fstream>
+#include <string_view>
 
 namespace rs = ranges;
 namespace ra = ranges::actions;
 namespace rv = ranges::views;
 
+namespace {
+
 int64_t combinations(int64_t d)
 {
     // TODO solve for the general case
@@ -50,26 +52,23 @@ int64_t part2(const std::vector<int>& input)
     // clang-format on
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2020 - Day 10\n");
+const aoc::solver_registrar registrar{
+    2020,
+    10,
+    [](std::string_view input) {
+        return part1(aoc::read_element_per_line<int>(input) | ra::sort);
+    },
+    [](std::string_view input) {
+        return part2(aoc::read_element_per_line<int>(input) | ra::sort);
+    }};
 
-    auto input = aoc::read_element_per_line<int>(std::ifstream{"puzzle.in"}) | ra::sort;
+} // namespace
 
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2(input));
-
-    return 0;
-}
-
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
 
-
 TEST_CASE("Can solve day 10 problems")
 {
     std::stringstream ss;
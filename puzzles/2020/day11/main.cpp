@@ -1,13 +1,18 @@
-#include <fmt/core.h>
+#include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
+
 #include <range/v3/all.hpp>
 
-#include <fstream>
+#include <memory_resource>
 #include <optional>
+#include <vector>
 
 namespace rs = ranges;
 namespace ra = ranges::actions;
 namespace rv = ranges::views;
 
+namespace {
+
 enum class direction {
     TOP_LEFT = 0,
     TOP_MIDDLE,
@@ -76,21 +81,23 @@ calculate_adjacent_index(int64_t map_size, int64_t stride, int64_t idx, directio
     return adjacent_idx;
 }
 
-std::vector<int64_t> find_adjacent_indexes(int64_t map_size, int64_t stride, int64_t idx)
+std::pmr::vector<int64_t>
+find_adjacent_indexes(int64_t map_size, int64_t stride, int64_t idx, aoc::arena& scratch)
 {
     auto adjacent_indexes = ALL_DIRECTIONS | rv::transform([map_size, stride, idx](auto dir) {
                                 return calculate_adjacent_index(map_size, stride, idx, dir);
                             })
                             | rv::filter([](const auto& idx) { return idx.has_value(); })
                             | rv::transform([](const auto& idx) { return idx.value(); })
-                            | rs::to<std::vector>;
+                            | aoc::to_vector(scratch);
 
     return adjacent_indexes;
 }
 
-int64_t count_occupied_adjacent(const std::vector<char>& input, int64_t stride, int64_t idx)
+int64_t
+count_occupied_adjacent(const std::vector<char>& input, int64_t stride, int64_t idx, aoc::arena& scratch)
 {
-    auto adjacent_indexes = find_adjacent_indexes(input.size(), stride, idx);
+    auto adjacent_indexes = find_adjacent_indexes(input.size(), stride, idx, scratch);
 
     return rs::distance(
         adjacent_indexes | rv::transform([&input](auto idx) { return input[idx] == '#'; })
@@ -117,13 +124,13 @@ int count_occupied_visible_adjacent(const std::vector<char>& input, int64_t stri
         0);
 }
 
-auto part1_map_rule(const std::vector<char>& input, int64_t stride)
+auto part1_map_rule(const std::vector<char>& input, int64_t stride, aoc::arena& scratch)
 {
-    return [&input, stride](auto&& rng) {
+    return [&input, stride, &scratch](auto&& rng) {
         auto [idx, c] = rng;
 
         if (c != '.') {
-            auto occupied_adjacents = count_occupied_adjacent(input, stride, idx);
+            auto occupied_adjacents = count_occupied_adjacent(input, stride, idx, scratch);
 
             if (c == 'L' && occupied_adjacents == 0) { c = '#'; }
             else if (c == '#' && occupied_adjacents >= 4) {
@@ -155,14 +162,20 @@ auto part2_map_rule(const std::vector<char>& input, int64_t stride)
 
 int64_t part1(std::vector<char> input, int64_t stride)
 {
-    int64_t last_counter, current_counter = rs::count(input, '#');
+    int64_t           last_counter, current_counter = rs::count(input, '#');
+    std::vector<char> tmp;
+    aoc::arena        scratch;
 
     do {
         last_counter = current_counter;
 
-        auto tmp = input;
+        // the neighbour lists of one generation are dropped together before the next one starts
+        scratch.reset();
+        tmp = input;
 
-        input = rv::enumerate(input) | rv::transform(part1_map_rule(tmp, stride)) | rs::to<std::vector>;
+        rs::copy(
+            rv::enumerate(tmp) | rv::transform(part1_map_rule(tmp, stride, scratch)),
+            input.begin());
 
         current_counter = rs::count(input, '#');
     } while (last_counter != current_counter);
@@ -172,14 +185,15 @@ int64_t part1(std::vector<char> input, int64_t stride)
 
 int64_t part2(std::vector<char> input, int64_t stride)
 {
-    int64_t last_counter, current_counter = rs::count(input, '#');
+    int64_t           last_counter, current_counter = rs::count(input, '#');
+    std::vector<char> tmp;
 
     do {
         last_counter = current_counter;
 
-        auto tmp = input;
+        tmp = input;
 
-        input = rv::enumerate(input) | rv::transform(part2_map_rule(tmp, stride)) | rs::to<std::vector>;
+        rs::copy(rv::enumerate(tmp) | rv::transform(part2_map_rule(tmp, stride)), input.begin());
 
         current_counter = rs::count(input, '#');
     } while (last_counter != current_counter);
@@ -187,26 +201,25 @@ int64_t part2(std::vector<char> input, int64_t stride)
     return current_counter;
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2020 - Day 11\n");
+const aoc::solver_registrar registrar{
+    2020,
+    11,
+    [](std::istream& input) {
+        auto [seats, stride] = read_input(std::move(input));
+        return part1(seats, stride);
+    },
+    [](std::istream& input) {
+        auto [seats, stride] = read_input(std::move(input));
+        return part2(seats, stride);
+    }};
 
-    auto [input, stride] = read_input(std::ifstream{"puzzle.in"});
+} // namespace
 
-    fmt::print("Part 1 Solution: {}\n", part1(input, stride));
-    fmt::print("Part 2 Solution: {}\n", part2(input, stride));
-
-    return 0;
-}
-
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
 
-
 TEST_CASE("Can solve day 11 problems")
 {
     std::stringstream ss;
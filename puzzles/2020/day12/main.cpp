@@ -1,15 +1,17 @@
-#include <fmt/core.h>
+#include <aoc/runner.hpp>
+
 #include <glm/vec2.hpp>
 #include <range/v3/all.hpp>
 
 #include <cmath>
-#include <fstream>
 #include <map>
 #include <vector>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 
+namespace {
+
 struct instruction {
     char dir;
     int  amount;
@@ -53,21 +55,15 @@ int navigate(const std::vector<instruction>& input, glm::ivec2 heading, bool fol
     return std::abs(ship_position.x) + std::abs(ship_position.y);
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2020 - Day 12\n");
+const aoc::solver_registrar registrar{
+    2020,
+    12,
+    [](std::istream& input) { return navigate(read_input(std::move(input)), directions.at('E')); },
+    [](std::istream& input) { return navigate(read_input(std::move(input)), {10, 1}, true); }};
 
-    auto input = read_input(std::ifstream{"puzzle.in"});
-
-    fmt::print("Part 1 Solution: {}\n", navigate(input, directions.at('E')));
-    fmt::print("Part 2 Solution: {}\n", navigate(input, {10, 1}, true));
-
-    return 0;
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
@@ -1,11 +1,12 @@
-#include <fmt/core.h>
-#include <range/v3/all.hpp>
+#include <aoc/runner.hpp>
 
-#include <fstream>
+#include <range/v3/all.hpp>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 
+namespace {
+
 std::pair<int, std::vector<int>> read_input(std::istream&& input)
 {
     std::string tmp;
@@ -58,21 +59,18 @@ int64_t part2(const std::vector<int>& schedules)
     return timestamp;
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2020 - Day 13\n");
-
-    auto [earliest_departure, schedules] = read_input(std::ifstream{"puzzle.in"});
+const aoc::solver_registrar registrar{
+    2020,
+    13,
+    [](std::istream& input) {
+        auto [earliest_departure, schedules] = read_input(std::move(input));
+        return part1(earliest_departure, schedules);
+    },
+    [](std::istream& input) { return part2(read_input(std::move(input)).second); }};
 
-    fmt::print("Part 1 Solution: {}\n", part1(earliest_departure, schedules));
-    fmt::print("Part 2 Solution: {}\n", part2(schedules));
-
-    return 0;
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
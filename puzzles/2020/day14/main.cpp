@@ -1,14 +1,16 @@
-#include <fmt/core.h>
+#include <aoc/runner.hpp>
+
 #include <range/v3/all.hpp>
 
 #include <bitset>
-#include <fstream>
 #include <map>
 #include <regex>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 
+namespace {
+
 std::string parse_to_bits(const std::string& s)
 {
     return std::bitset<36>{static_cast<uint64_t>(std::stoll(s))}.to_string();
@@ -108,21 +110,15 @@ int64_t part2(std::istream&& input)
     return rs::accumulate(nums | rv::values, int64_t{0});
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2020 - Day 14\n");
+const aoc::solver_registrar registrar{
+    2020,
+    14,
+    [](std::istream& input) { return part1(std::move(input)); },
+    [](std::istream& input) { return part2(std::move(input)); }};
 
-    std::string input_path = "puzzle.in";
-
-    fmt::print("Part 1 Solution: {}\n", part1(std::ifstream{input_path}));
-    fmt::print("Part 2 Solution: {}\n", part2(std::ifstream{input_path}));
-
-    return 0;
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
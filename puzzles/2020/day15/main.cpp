@@ -1,14 +1,19 @@
-#include <fmt/core.h>
+#include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
+#include <aoc/trace.hpp>
+
 #include <range/v3/all.hpp>
 
 #include <cstdint>
-#include <fstream>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 
+namespace {
+
 int solve(const std::vector<int>& input, int nth_number)
 {
     // clang-format off
@@ -24,9 +29,11 @@ int solve(const std::vector<int>& input, int nth_number)
 
     for (int i : rv::iota(static_cast<int>(input.size()), nth_number)) {
         if (cache.contains(last_number)) {
+            AOC_TRACE_COUNT("2020/day15/cache hits", 1);
             std::tie(last_number, cache[last_number]) = std::make_tuple(i - cache[last_number], i);
         }
         else {
+            AOC_TRACE_COUNT("2020/day15/cache misses", 1);
             cache[last_number] = i;
             last_number        = 0;
         }
@@ -35,21 +42,15 @@ int solve(const std::vector<int>& input, int nth_number)
     return last_number;
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2020 - Day 15\n");
+const aoc::solver_registrar registrar{
+    2020,
+    15,
+    [](std::string_view input) { return solve(aoc::split_line_by<int>(input), 2020); },
+    [](std::string_view input) { return solve(aoc::split_line_by<int>(input), 30000000); }};
 
-    std::vector<int> input = {1, 0, 18, 10, 19, 6};
-
-    fmt::print("Part 1 Solution: {}\n", solve(input, 2020));
-    fmt::print("Part 2 Solution: {}\n", solve(input, 30000000));
-
-    return 0;
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
@@ -1,4 +1,4 @@
-#include <fmt/format.h>
+#include <aoc/runner.hpp>
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -9,13 +9,14 @@
 #pragma warning(pop)
 #endif
 
-#include <fstream>
 #include <iostream>
 #include <set>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 
+namespace {
+
 struct rule {
     std::string                        name;
     std::array<std::pair<int, int>, 2> valid_ranges;
@@ -142,21 +143,15 @@ int64_t part2(const document& input, const std::string& search_field)
 }
 
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2020 - Day 16\n");
-
-    auto input = read_input(std::ifstream{"puzzle.in"});
-
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2(input, "departure"));
+const aoc::solver_registrar registrar{
+    2020,
+    16,
+    [](std::istream& input) { return part1(read_input(std::move(input))); },
+    [](std::istream& input) { return part2(read_input(std::move(input)), "departure"); }};
 
-    return 0;
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
@@ -1,15 +1,17 @@
-#include <fmt/format.h>
+#include <aoc/runner.hpp>
+
 #define GLM_ENABLE_EXPERIMENTAL
 #include "glm/gtx/hash.hpp"
 #include <glm/vec3.hpp>
 #include <range/v3/all.hpp>
 
-#include <fstream>
 #include <unordered_map>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 
+namespace {
+
 template <typename T>
 using grid_t = std::unordered_map<T, bool>;
 
@@ -107,21 +109,15 @@ int64_t solve(grid_t<T> grid)
     return rs::count(grid | rv::values, true);
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2020 - Day 17\n");
+const aoc::solver_registrar registrar{
+    2020,
+    17,
+    [](std::istream& input) { return solve(read_input_grid<glm::ivec3>(std::move(input))); },
+    [](std::istream& input) { return solve(read_input_grid<glm::ivec4>(std::move(input))); }};
 
-    std::string input_path = "puzzle.in";
-
-    fmt::print("Part 1 Solution: {}\n", solve(read_input_grid<glm::ivec3>(std::ifstream{input_path})));
-    fmt::print("Part 2 Solution: {}\n", solve(read_input_grid<glm::ivec4>(std::ifstream{input_path})));
-
-    return 0;
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
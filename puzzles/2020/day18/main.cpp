@@ -1,13 +1,15 @@
-#include <fmt/format.h>
+#include <aoc/runner.hpp>
+
 #include <range/v3/all.hpp>
 
-#include <fstream>
 #include <sstream>
 #include <string>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 
+namespace {
+
 int64_t solve_expression(std::istream& expr)
 {
     int64_t solution = 0;
@@ -121,21 +123,15 @@ int64_t part2(std::istream&& input)
     return rs::accumulate(solutions, int64_t{0});
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2020 - Day 18\n");
+const aoc::solver_registrar registrar{
+    2020,
+    18,
+    [](std::istream& input) { return part1(std::move(input)); },
+    [](std::istream& input) { return part2(std::move(input)); }};
 
-    std::string input_path = "puzzle.in";
-
-    fmt::print("Part 1 Solution: {}\n", part1(std::ifstream{input_path}));
-    fmt::print("Part 2 Solution: {}\n", part2(std::ifstream{input_path}));
-
-    return 0;
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
@@ -1,8 +1,8 @@
-#include <fmt/format.h>
+#include <aoc/runner.hpp>
+
 #include <range/v3/all.hpp>
 
 #include <cctype>
-#include <fstream>
 #include <iostream>
 #include <regex>
 #include <unordered_map>
@@ -11,6 +11,8 @@
 namespace rs = ranges;
 namespace rv = ranges::views;
 
+namespace {
+
 struct rule {
     enum class TYPE { MATCH, SUBRULE };
     TYPE                          type;
@@ -108,23 +110,21 @@ int64_t part2(std::unordered_map<int, rule> rules, const std::vector<std::string
         messages | rv::filter([&rules](const auto& s) { return match(rules, rules.at(0), s); }));
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2020 - Day 19\n");
-
-    std::string input_path = "puzzle.in";
-
-    auto [rules, messages] = read_input(std::ifstream{input_path});
-
-    fmt::print("Part 1 Solution: {}\n", part1(rules, messages));
-    fmt::print("Part 2 Solution: {}\n", part2(rules, messages));
-
-    return 0;
-}
-
-#else
+const aoc::solver_registrar registrar{
+    2020,
+    19,
+    [](std::istream& input) {
+        auto [rules, messages] = read_input(std::move(input));
+        return part1(rules, messages);
+    },
+    [](std::istream& input) {
+        auto [rules, messages] = read_input(std::move(input));
+        return part2(rules, messages);
+    }};
+
+} // namespace
+
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
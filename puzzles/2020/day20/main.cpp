@@ -1,10 +1,8 @@
 #include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/format.h>
 #include <range/v3/all.hpp>
 
-#include <fstream>
-
 #include <iostream>
 #include <map>
 #include <optional>
@@ -13,6 +11,8 @@
 namespace rs = ranges;
 namespace rv = ranges::views;
 
+namespace {
+
 struct tile {
     int64_t                        id;
     std::vector<std::vector<char>> image_data;
@@ -337,23 +337,19 @@ int64_t part2(std::map<tile, std::vector<tile>, tile_compare> neighbor_map, int
     return water_roughness - (monsters_found * tiles_per_monster);
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2020 - Day 20\n");
-
-    auto input        = read_input(std::ifstream{"puzzle.in"});
-    auto neighbor_map = build_neighbor_map(input);
-    auto width        = static_cast<int>(std::sqrt(neighbor_map.size()));
-
-    fmt::print("Part 1 Solution: {}\n", part1(neighbor_map));
-    fmt::print("Part 2 Solution: {}\n", part2(neighbor_map, width));
+const aoc::solver_registrar registrar{
+    2020,
+    20,
+    [](std::istream& input) { return part1(build_neighbor_map(read_input(std::move(input)))); },
+    [](std::istream& input) {
+        auto neighbor_map = build_neighbor_map(read_input(std::move(input)));
+        auto width        = static_cast<int>(std::sqrt(neighbor_map.size()));
+        return part2(neighbor_map, width);
+    }};
 
-    return 0;
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
@@ -1,7 +1,7 @@
-#include <fmt/format.h>
+#include <aoc/runner.hpp>
+
 #include <range/v3/all.hpp>
 
-#include <fstream>
 #include <iostream>
 #include <map>
 #include <optional>
@@ -12,6 +12,8 @@ namespace rs = ranges;
 namespace ra = ranges::actions;
 namespace rv = ranges::views;
 
+namespace {
+
 struct food {
     std::vector<std::string> ingredients;
     std::vector<std::string> allergens;
@@ -114,23 +116,15 @@ std::string part2(std::vector<food> food_list)
     return allergens | rv::join(',') | rs::to<std::string>;
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2020 - Day 21\n");
-
-    std::string input_path = "puzzle.in";
-
-    auto food_list = read_input(std::ifstream{input_path});
+const aoc::solver_registrar registrar{
+    2020,
+    21,
+    [](std::istream& input) { return part1(read_input(std::move(input))); },
+    [](std::istream& input) { return part2(read_input(std::move(input))); }};
 
-    fmt::print("Part 1 Solution: {}\n", part1(food_list));
-    fmt::print("Part 2 Solution: {}\n", part2(food_list));
-
-    return 0;
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
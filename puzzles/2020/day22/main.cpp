@@ -1,14 +1,16 @@
-#include <fmt/format.h>
+#include <aoc/runner.hpp>
+
 #include <range/v3/all.hpp>
 
 #include <deque>
-#include <fstream>
 #include <iostream>
 #include <optional>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 
+namespace {
+
 std::vector<std::deque<int>> read_starting_decks(std::istream&& input)
 {
     return rs::getlines(input) | rv::split("") | rv::transform([](auto&& rng) {
@@ -104,23 +106,15 @@ int64_t part2(std::vector<std::deque<int>> decks)
     return calculate_deck_score(play_recursive_combat(decks).second);
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2020 - Day 22\n");
-
-    std::string input_path = "puzzle.in";
-
-    auto decks = read_starting_decks(std::ifstream{input_path});
+const aoc::solver_registrar registrar{
+    2020,
+    22,
+    [](std::istream& input) { return part1(read_starting_decks(std::move(input))); },
+    [](std::istream& input) { return part2(read_starting_decks(std::move(input))); }};
 
-    fmt::print("Part 1 Solution: {}\n", part1(decks));
-    fmt::print("Part 2 Solution: {}\n", part2(decks));
-
-    return 0;
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
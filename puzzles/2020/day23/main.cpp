@@ -1,12 +1,23 @@
-#include <fmt/format.h>
+#include <aoc/runner.hpp>
+
 #include <range/v3/all.hpp>
 
-#include <fstream>
 #include <list>
+#include <string>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 
+namespace {
+
+std::string read_input(std::istream& input)
+{
+    std::string cups;
+    std::getline(input, cups);
+
+    return cups;
+}
+
 std::vector<int> parse_input1(const std::string& input, int size)
 {
     std::vector<int> cups;
@@ -91,21 +102,15 @@ int64_t part2(const std::string& input)
     return static_cast<int64_t>(cups[1]) * static_cast<int64_t>(cups[cups[1]]);
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2020 - Day 23\n");
-
-    std::string input = "589174263";
-
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2(input));
+const aoc::solver_registrar registrar{
+    2020,
+    23,
+    [](std::istream& input) { return part1(read_input(input)); },
+    [](std::istream& input) { return part2(read_input(input)); }};
 
-    return 0;
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
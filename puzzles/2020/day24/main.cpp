@@ -1,16 +1,18 @@
-#include <fmt/format.h>
+#include <aoc/runner.hpp>
+
 #define GLM_ENABLE_EXPERIMENTAL
 #include "glm/gtx/hash.hpp"
 #include <glm/vec3.hpp>
 #include <range/v3/all.hpp>
 
-#include <fstream>
 #include <queue>
 #include <unordered_map>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 
+namespace {
+
 void pad_grid(std::unordered_map<glm::ivec3, int>& grid)
 {
     for (auto [pos, val] : grid) {
@@ -111,22 +113,15 @@ int64_t part2(std::unordered_map<glm::ivec3, int> grid)
     return black_tiles;
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2020 - Day 24\n");
+const aoc::solver_registrar registrar{
+    2020,
+    24,
+    [](std::istream& input) { return part1(read_input(input)); },
+    [](std::istream& input) { return part2(read_input(input)); }};
 
-    auto input = std::ifstream{"puzzle.in"};
-    auto grid  = read_input(input);
-
-    fmt::print("Part 1 Solution: {}\n", part1(grid));
-    fmt::print("Part 2 Solution: {}\n", part2(grid));
-
-    return 0;
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
@@ -1,11 +1,12 @@
-#include <fmt/format.h>
-#include <range/v3/all.hpp>
+#include <aoc/runner.hpp>
 
-#include <fstream>
+#include <range/v3/all.hpp>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 
+namespace {
+
 std::vector<int> read_input(std::istream& input)
 {
     return rs::getlines(input)
@@ -37,21 +38,14 @@ int64_t part1(std::vector<int> public_keys)
     return transform_subject(public_keys[1], loops_to_reach(7, public_keys[0]));
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2020 - Day 25\n");
-
-    auto input       = std::ifstream{"puzzle.in"};
-    auto public_keys = read_input(input);
+const aoc::solver_registrar registrar{
+    2020,
+    25,
+    [](std::istream& input) { return part1(read_input(input)); }};
 
-    fmt::print("Part 1 Solution: {}\n", part1(public_keys));
-
-    return 0;
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
@@ -1,15 +1,17 @@
 
 #include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
 #include <cstdint>
-#include <fstream>
+#include <string_view>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 
+namespace {
+
 int64_t accumulate_depth_increases(auto&& r)
 {
     // clang-format off
@@ -39,19 +41,15 @@ int64_t part2(const std::vector<int>& input)
     return accumulate_depth_increases(depth_accumulations);
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 01\n");
+const aoc::solver_registrar registrar{
+    2021,
+    1,
+    [](std::string_view input) { return part1(aoc::read_element_per_line<int>(input)); },
+    [](std::string_view input) { return part2(aoc::read_element_per_line<int>(input)); }};
 
-    auto input = aoc::read_element_per_line<int>(std::ifstream{"puzzle.in"});
-
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2(input));
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
@@ -1,9 +1,8 @@
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <glm/vec2.hpp>
 #include <range/v3/all.hpp>
 
-#include <fstream>
 #include <numeric>
 #include <string>
 #include <vector>
@@ -12,6 +11,8 @@
 namespace rs = ranges;
 namespace rv = ranges::views;
 
+namespace {
+
 int part1(std::istream&& input)
 {
     glm::ivec2 pos{0, 0};
@@ -50,19 +51,15 @@ int part2(std::istream&& input)
     return pos.x * pos.y;
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 02\n");
+const aoc::solver_registrar registrar{
+    2021,
+    2,
+    [](std::istream& input) { return part1(std::move(input)); },
+    [](std::istream& input) { return part2(std::move(input)); }};
 
-    std::string input_path = "puzzle.in";
-
-    fmt::print("Part 1 Solution: {}\n", part1(std::ifstream{input_path}));
-    fmt::print("Part 2 Solution: {}\n", part2(std::ifstream{input_path}));
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
@@ -1,12 +1,12 @@
 
 #include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
-
-#include <fstream>
 #include <string>
 #include <vector>
 
+namespace {
+
 int filter_values(std::vector<std::string> input, bool most_common = true)
 {
     int i = 0;
@@ -67,19 +67,19 @@ int part2(std::vector<std::string> input)
     return oxygen_rating * c02_rating;
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 03\n");
-
-    auto input = aoc::read_element_per_line<std::string>(std::ifstream{"puzzle.in"});
+const aoc::solver_registrar registrar{
+    2021,
+    3,
+    [](std::istream& input) {
+        return part1(aoc::read_element_per_line<std::string>(std::move(input)));
+    },
+    [](std::istream& input) {
+        return part2(aoc::read_element_per_line<std::string>(std::move(input)));
+    }};
 
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2(input));
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
@@ -1,9 +1,8 @@
 #include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
-#include <fstream>
 #include <iostream>
 #include <limits>
 #include <string>
@@ -12,6 +11,8 @@
 namespace rs = ranges;
 namespace rv = ranges::views;
 
+namespace {
+
 struct board_position_t {
     int  number;
     bool marked = false;
@@ -151,19 +152,15 @@ int part2(bingo_subsystem_t bingo_subsystem)
     return winning_score * winning_number;
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 04\n");
+const aoc::solver_registrar registrar{
+    2021,
+    4,
+    [](std::istream& input) { return part1(read_input(std::move(input))); },
+    [](std::istream& input) { return part2(read_input(std::move(input))); }};
 
-    auto input = read_input(std::ifstream{"puzzle.in"});
-
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2(input));
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
@@ -1,12 +1,11 @@
 #include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/hash.hpp>
 #include <glm/vec2.hpp>
 #include <range/v3/all.hpp>
 
-#include <fstream>
 #include <unordered_map>
 #include <regex>
 #include <string>
@@ -14,6 +13,8 @@
 namespace rs = ranges;
 namespace rv = ranges::views;
 
+namespace {
+
 struct line_t {
     glm::ivec2 a;
     glm::ivec2 b;
@@ -81,19 +82,15 @@ int part2(const std::vector<line_t>& lines)
     return count_overlaps(lines);
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 05\n");
+const aoc::solver_registrar registrar{
+    2021,
+    5,
+    [](std::istream& input) { return part1(read_input(std::move(input))); },
+    [](std::istream& input) { return part2(read_input(std::move(input))); }};
 
-    auto input = read_input(std::ifstream{"puzzle.in"});
-
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2(input));
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
@@ -1,16 +1,18 @@
 #include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
 #include <array>
-#include <fstream>
 #include <map>
 #include <cstdint>
+#include <string_view>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 
+namespace {
+
 uint64_t simulate(std::vector<int> input, int days)
 {
     std::array<uint64_t, 9> timers{};
@@ -37,20 +39,15 @@ size_t part2(std::vector<int> input)
     return simulate(input, 256);
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 06\n");
+const aoc::solver_registrar registrar{
+    2021,
+    6,
+    [](std::string_view input) { return part1(aoc::split_line_by<int>(input)); },
+    [](std::string_view input) { return part2(aoc::split_line_by<int>(input)); }};
 
-    std::ifstream ifs{"puzzle.in"};
-    auto          input = aoc::split_line_by<int>(ifs);
-
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2(input));
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
@@ -1,14 +1,16 @@
 #include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
-#include <fstream>
+#include <string_view>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 namespace ra = ranges::actions;
 
+namespace {
+
 int part1(std::vector<int> input)
 {
     int fuel = std::numeric_limits<int>::max();
@@ -44,25 +46,19 @@ int part2(std::vector<int> input)
     return fuel;
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 07\n");
-
-    std::ifstream ifs{"puzzle.in"};
-    auto          input = aoc::split_line_by<int>(ifs);
+const aoc::solver_registrar registrar{
+    2021,
+    7,
+    [](std::string_view input) { return part1(aoc::split_line_by<int>(input)); },
+    [](std::string_view input) { return part2(aoc::split_line_by<int>(input)); }};
 
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2(input));
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
 
-
 TEST_CASE("Can solve part 1 example")
 {
     std::stringstream ss;
@@ -1,14 +1,13 @@
 #include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
-#include <fstream>
-
 namespace rs = ranges;
 namespace rv = ranges::views;
 namespace ra = ranges::actions;
 
+namespace {
 
 using Display = uint8_t;
 
@@ -230,34 +229,24 @@ int part2(const std::vector<calibration_t>& input)
     return 0;
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 08\n");
-
-    std::ifstream ifs{"puzzle.in"};
-    // auto          input = read_input(std::move(ifs));
-
-
-    std::string input_line;
-    uint64_t    part1_total = 0;
-    uint64_t    part2_total = 0;
-    while (std::getline(ifs, input_line)) {
-        Puzzle p = parse_line(input_line);
-        part1_total += std::ranges::count_if(p.numbers, [](auto num) {
-            uint8_t cnt = cnt_segments(num);
-            return cnt == 2 || cnt == 3 || cnt == 4 || cnt == 7;
-        });
-        Wiring w = solve_wiring(p);
-        part2_total += decode_number(p, w);
-    }
+const aoc::solver_registrar registrar{
+    2021,
+    8,
+    [](std::istream& input) { return part1(read_input(std::move(input))); },
+    [](std::istream& input) {
+        std::string input_line;
+        uint64_t    total = 0;
+        while (std::getline(input, input_line)) {
+            Puzzle p = parse_line(input_line);
+            Wiring w = solve_wiring(p);
+            total += decode_number(p, w);
+        }
+        return total;
+    }};
 
-    fmt::print("Part 1 Solution: {}\n", part1_total);
-    fmt::print("Part 2 Solution: {}\n", part2_total);
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
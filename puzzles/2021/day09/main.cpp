@@ -1,102 +1,67 @@
 #include <aoc/aoc.hpp>
+#include <aoc/grid.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
-#include <fstream>
+#include <string_view>
 #include <vector>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 namespace ra = ranges::actions;
 
-std::vector<std::vector<int>> read_input(std::istream& input)
+namespace {
+
+using heightmap_t = aoc::grid<int>;
+
+// the border is as high as a basin wall, so nothing needs a bounds check
+heightmap_t read_input(std::string_view input)
 {
-    return rs::getlines(input) | rv::transform([](auto&& s) {
-               return s | rv::transform([](char c) { return c - '0'; }) | rs::to<std::vector>;
-           })
-           | rs::to<std::vector>;
+    return heightmap_t::parse(input, [](char c) { return c - '0'; }, 1, 9);
 }
 
-int part1(const std::vector<std::vector<int>>& input)
+bool is_low_point(const heightmap_t& input, aoc::grid_point p)
 {
-    int risk_levels_sum = 0;
-
-    for (int y = 0; y < input.size(); ++y) {
-        for (int x = 0; x < input[y].size(); ++x) {
-            int i = input[y][x];
-
-            bool low = true;
-
-            // check up
-            if (y > 0) { low = low && i < input[y - 1][x]; }
-            // check down
-            if (y < input.size() - 1) { low = low && i < input[y + 1][x]; }
-            // check left
-            if (x > 0) { low = low && i < input[y][x - 1]; }
-            // check right
-            if (x < input[y].size() - 1) { low = low && i < input[y][x + 1]; }
+    return rs::all_of(input.neighbors(p, aoc::neighbors_4), [&](auto n) { return input[p] < input[n]; });
+}
 
+int part1(const heightmap_t& input)
+{
+    int risk_levels_sum = 0;
 
-            if (low) risk_levels_sum += i + 1;
+    for (std::ptrdiff_t y = 0; y < static_cast<std::ptrdiff_t>(input.rows()); ++y) {
+        for (std::ptrdiff_t x = 0; x < static_cast<std::ptrdiff_t>(input.cols()); ++x) {
+            if (is_low_point(input, {y, x})) risk_levels_sum += input(y, x) + 1;
         }
     }
 
     return risk_levels_sum;
 }
 
-bool contains(const std::vector<std::pair<int, int>>& explored, int x, int y)
-{
-    auto it = rs::find(explored, std::pair{x, y});
-    return it != explored.end();
-}
-
-int explore_basin(
-    const std::vector<std::vector<int>>& input,
-    int                                  x,
-    int                                  y,
-    std::vector<std::pair<int, int>>&    explored)
+int explore_basin(const heightmap_t& input, aoc::grid_point p, aoc::grid<char>& explored)
 {
-    if (contains(explored, x, y) || input[y][x] == 9) return 0;
+    if (explored[p] || input[p] == 9) return 0;
 
-    explored.push_back({x, y});
+    explored[p]         = true;
     int points_in_basin = 1;
 
-    // check up
-    if (y > 0) { points_in_basin += explore_basin(input, x, y - 1, explored); }
-    // check down
-    if (y < input.size() - 1) { points_in_basin += explore_basin(input, x, y + 1, explored); }
-    // check left
-    if (x > 0) { points_in_basin += explore_basin(input, x - 1, y, explored); }
-    // check right
-    if (x < input[y].size() - 1) { points_in_basin += explore_basin(input, x + 1, y, explored); }
+    for (auto n : input.neighbors(p, aoc::neighbors_4)) {
+        points_in_basin += explore_basin(input, n, explored);
+    }
 
     return points_in_basin;
 }
 
-int part2(const std::vector<std::vector<int>>& input)
+int part2(const heightmap_t& input)
 {
     std::vector<int> basins;
+    aoc::grid<char>  explored(input.rows(), input.cols(), false, 1);
 
-    for (int y = 0; y < input.size(); ++y) {
-        for (int x = 0; x < input[y].size(); ++x) {
-            int i = input[y][x];
-
-            bool low = true;
-
-            // check up
-            if (y > 0) { low = low && i < input[y - 1][x]; }
-            // check down
-            if (y < input.size() - 1) { low = low && i < input[y + 1][x]; }
-            // check left
-            if (x > 0) { low = low && i < input[y][x - 1]; }
-            // check right
-            if (x < input[y].size() - 1) { low = low && i < input[y][x + 1]; }
-
-
-            if (low) {
-                std::vector<std::pair<int, int>> visited;
-                basins.push_back(explore_basin(input, x, y, visited));
+    for (std::ptrdiff_t y = 0; y < static_cast<std::ptrdiff_t>(input.rows()); ++y) {
+        for (std::ptrdiff_t x = 0; x < static_cast<std::ptrdiff_t>(input.cols()); ++x) {
+            if (is_low_point(input, {y, x})) {
+                basins.push_back(explore_basin(input, {y, x}, explored));
             }
         }
     }
@@ -106,48 +71,36 @@ int part2(const std::vector<std::vector<int>>& input)
     return rs::accumulate(basins | rv::reverse | rv::take(3), 1, std::multiplies<>());
 }
 
-#ifndef UNIT_TESTING
+const aoc::solver_registrar registrar{
+    2021,
+    9,
+    [](std::string_view input) { return part1(read_input(input)); },
+    [](std::string_view input) { return part2(read_input(input)); }};
 
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 09\n");
+} // namespace
 
-    std::ifstream ifs{"puzzle.in"};
-    auto          input = read_input(ifs);
-
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2(input));
-}
-
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
-#include <sstream>
 
 TEST_CASE("Can solve part 1 example")
 {
-    std::stringstream ss;
-    ss << R"(2199943210
+    auto input = read_input(R"(2199943210
 3987894921
 9856789892
 8767896789
-9899965678)";
-
-    auto input = read_input(ss);
+9899965678)");
 
     REQUIRE(15 == part1(input));
 }
 
 TEST_CASE("Can solve part 2 example")
 {
-    std::stringstream ss;
-    ss << R"(2199943210
+    auto input = read_input(R"(2199943210
 3987894921
 9856789892
 8767896789
-9899965678)";
-
-    auto input = read_input(ss);
+9899965678)");
 
     REQUIRE(1134 == part2(input));
 }
@@ -1,15 +1,16 @@
 #include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
-#include <fstream>
 #include <stack>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 namespace ra = ranges::actions;
 
+namespace {
+
 int score_error(char c)
 {
     return (')' == c) ? 3 : (']' == c) ? 57 : ('}' == c) ? 1197 : ('>' == c) ? 25137 : 0;
@@ -108,20 +109,15 @@ int64_t part2(const std::vector<std::string>& input)
     return scores[scores.size() / 2];
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 10\n");
+const aoc::solver_registrar registrar{
+    2021,
+    10,
+    [](std::istream& input) { return part1(read_input(input)); },
+    [](std::istream& input) { return part2(read_input(input)); }};
 
-    std::ifstream ifs{"puzzle.in"};
-    auto          input = read_input(ifs);
-
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2(input));
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
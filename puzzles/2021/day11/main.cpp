@@ -1,105 +1,59 @@
-#include <aoc/aoc.hpp>
+#include <aoc/grid.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
-#include <fstream>
+#include <cstddef>
+#include <string_view>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 namespace ra = ranges::actions;
 
-std::vector<std::vector<int>> read_input(std::istream& input)
-{
-    return rs::getlines(input) | rv::transform([](auto&& s) {
-               return s | rv::transform([](char c) { return c - '0'; }) | rs::to<std::vector>;
-           })
-           | rs::to<std::vector>;
-}
+namespace {
+
+using octopuses_t = aoc::grid<int>;
 
-bool contains(const std::vector<std::pair<int, int>>& explored, int x, int y)
+octopuses_t read_input(std::string_view input)
 {
-    auto it = rs::find(explored, std::pair{x, y});
-    return it != explored.end();
+    return octopuses_t::parse(input, [](char c) { return c - '0'; });
 }
 
-void explore(
-    std::vector<std::vector<int>>&    input,
-    int                               x,
-    int                               y,
-    std::vector<std::pair<int, int>>& flashed)
+void explore(octopuses_t& input, aoc::grid_point p, aoc::grid<char>& flashed)
 {
-    if (contains(flashed, x, y)) return;
+    if (flashed[p]) return;
 
-    flashed.push_back({x, y});
+    flashed[p] = true;
 
-    // check up
-    if (y > 0) {
-        input[y - 1][x]++;
-        if (input[y - 1][x] > 9) { explore(input, x, y - 1, flashed); }
-    }
-    // check up-left
-    if (y > 0 && x > 0) {
-        input[y - 1][x - 1]++;
-        if (input[y - 1][x - 1] > 9) { explore(input, x - 1, y - 1, flashed); }
-    }
-    // check left
-    if (x > 0) {
-        input[y][x - 1]++;
-        if (input[y][x - 1] > 9) { explore(input, x - 1, y, flashed); }
-    }
-    // check down-left
-    if (y < input.size() - 1 && x > 0) {
-        input[y + 1][x - 1]++;
-        if (input[y + 1][x - 1] > 9) { explore(input, x - 1, y + 1, flashed); }
-    }
-    // check down
-    if (y < input.size() - 1) {
-        input[y + 1][x]++;
-        if (input[y + 1][x] > 9) { explore(input, x, y + 1, flashed); }
-    }
-    // check down-right
-    if (y < input.size() - 1 && x < input[y].size() - 1) {
-        input[y + 1][x + 1]++;
-        if (input[y + 1][x + 1] > 9) { explore(input, x + 1, y + 1, flashed); }
-    }
-    // check right
-    if (x < input[y].size() - 1) {
-        input[y][x + 1]++;
-        if (input[y][x + 1] > 9) { explore(input, x + 1, y, flashed); }
-    }
-    // check up-right
-    if (y > 0 && x < input[y].size() - 1) {
-        input[y - 1][x + 1]++;
-        if (input[y - 1][x + 1] > 9) { explore(input, x + 1, y - 1, flashed); }
+    for (auto n : input.neighbors(p, aoc::neighbors_8)) {
+        if (++input[n] > 9) { explore(input, n, flashed); }
     }
 }
 
-int part1(std::vector<std::vector<int>> input)
+// Advances one step and returns how many octopuses flashed during it.
+int step(octopuses_t& input, aoc::grid<char>& flashed)
 {
-    int flashes = 0;
+    flashed.fill(false);
 
-    for (int i = 0; i < 100; ++i) {
-        for (auto& row : input) {
-            for (auto& pos : row) {
-                ++pos;
-            }
+    for (std::size_t y = 0; y < input.rows(); ++y) {
+        for (auto& pos : input.row(y)) {
+            ++pos;
         }
+    }
 
-        std::vector<std::pair<int, int>> flashed;
-
-        for (int y = 0; y < input.size(); ++y) {
-            for (int x = 0; x < input[y].size(); ++x) {
-                if (input[y][x] > 9) { explore(input, x, y, flashed); }
-            }
+    for (std::ptrdiff_t y = 0; y < static_cast<std::ptrdiff_t>(input.rows()); ++y) {
+        for (std::ptrdiff_t x = 0; x < static_cast<std::ptrdiff_t>(input.cols()); ++x) {
+            if (input(y, x) > 9) { explore(input, {y, x}, flashed); }
         }
+    }
+
+    int flashes = 0;
 
-        for (auto& row : input) {
-            for (auto& pos : row) {
-                if (pos > 9) {
-                    ++flashes;
-                    pos = 0;
-                }
+    for (std::size_t y = 0; y < input.rows(); ++y) {
+        for (auto& pos : input.row(y)) {
+            if (pos > 9) {
+                ++flashes;
+                pos = 0;
             }
         }
     }
@@ -107,68 +61,47 @@ int part1(std::vector<std::vector<int>> input)
     return flashes;
 }
 
-int part2(std::vector<std::vector<int>> input)
+int part1(octopuses_t input)
 {
-    int flashes = 0;
-    int turn    = 0;
-
-    size_t num_octs = input.size() * input[0].size();
+    int             flashes = 0;
+    aoc::grid<char> flashed(input.rows(), input.cols());
 
-    while (flashes != num_octs) {
-        flashes = 0;
-
-        for (auto& row : input) {
-            for (auto& pos : row) {
-                ++pos;
-            }
-        }
+    for (int i = 0; i < 100; ++i) {
+        flashes += step(input, flashed);
+    }
 
-        std::vector<std::pair<int, int>> flashed;
+    return flashes;
+}
 
-        for (int y = 0; y < input.size(); ++y) {
-            for (int x = 0; x < input[y].size(); ++x) {
-                if (input[y][x] > 9) { explore(input, x, y, flashed); }
-            }
-        }
+int part2(octopuses_t input)
+{
+    int             turn = 0;
+    aoc::grid<char> flashed(input.rows(), input.cols());
 
-        for (auto& row : input) {
-            for (auto& pos : row) {
-                if (pos > 9) {
-                    ++flashes;
-                    pos = 0;
-                }
-            }
-        }
+    size_t num_octs = input.rows() * input.cols();
 
+    do {
         ++turn;
-    }
+    } while (static_cast<size_t>(step(input, flashed)) != num_octs);
 
     return turn;
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 11\n");
-
-    std::ifstream ifs{"puzzle.in"};
-    auto          input = read_input(ifs);
-
+const aoc::solver_registrar registrar{
+    2021,
+    11,
+    [](std::string_view input) { return part1(read_input(input)); },
+    [](std::string_view input) { return part2(read_input(input)); }};
 
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2(input));
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
-#include <sstream>
 
 TEST_CASE("Can solve part 1 example")
 {
-    std::stringstream ss;
-    ss << R"(5483143223
+    auto input = read_input(R"(5483143223
 2745854711
 5264556173
 6141336146
@@ -177,17 +110,14 @@ TEST_CASE("Can solve part 1 example")
 2176841721
 6882881134
 4846848554
-5283751526)";
-
-    auto input = read_input(ss);
+5283751526)");
 
     REQUIRE(1656 == part1(input));
 }
 
 TEST_CASE("Can solve part 2 example")
 {
-    std::stringstream ss;
-    ss << R"(5483143223
+    auto input = read_input(R"(5483143223
 2745854711
 5264556173
 6141336146
@@ -196,9 +126,7 @@ TEST_CASE("Can solve part 2 example")
 2176841721
 6882881134
 4846848554
-5283751526)";
-
-    auto input = read_input(ss);
+5283751526)");
 
     REQUIRE(195 == part2(input));
 }
@@ -1,14 +1,14 @@
 #include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
-#include <fstream>
-
 namespace rs = ranges;
 namespace rv = ranges::views;
 namespace ra = ranges::actions;
 
+namespace {
+
 using path_t = std::vector<std::string>;
 
 using transition_t = std::pair<std::string, std::string>;
@@ -178,20 +178,15 @@ int64_t part2(const std::vector<transition_t>& transitions)
     return paths.size();
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 12\n");
-
-    std::ifstream ifs{"puzzle.in"};
-    auto          input = read_input(ifs);
+const aoc::solver_registrar registrar{
+    2021,
+    12,
+    [](std::istream& input) { return part1(read_input(input)); },
+    [](std::istream& input) { return part2(read_input(input)); }};
 
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2(input));
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
@@ -1,6 +1,7 @@
 #include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
+#include <fmt/format.h>
 #include <glm/vec2.hpp>
 
 #define GLM_ENABLE_EXPERIMENTAL
@@ -8,13 +9,14 @@
 
 #include <range/v3/all.hpp>
 
-#include <fstream>
 #include <unordered_set>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 namespace ra = ranges::actions;
 
+namespace {
+
 struct puzzle_t {
     std::unordered_set<glm::ivec2> dots;
     std::vector<glm::ivec2>        folds;
@@ -122,24 +124,17 @@ std::vector<std::string> part2(puzzle_t input)
     return display;
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 13\n");
-
-    std::ifstream ifs{"puzzle.in"};
-    auto          input = read_input(ifs);
+const aoc::solver_registrar registrar{
+    2021,
+    13,
+    [](std::istream& input) { return part1(read_input(input)); },
+    [](std::istream& input) {
+        return fmt::format("\n\n{}", fmt::join(part2(read_input(input)), "\n"));
+    }};
 
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution\n\n");
-
-    for (const auto& l : part2(input)) {
-        fmt::print("{}\n", l);
-    }
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
@@ -1,9 +1,8 @@
 #include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
-#include <fstream>
 #include <unordered_map>
 #include <vector>
 
@@ -21,6 +20,8 @@ struct std::hash<std::pair<char, char>> {
     }
 };
 
+namespace {
+
 using insertion_rules_t = std::unordered_map<std::pair<char, char>, char>;
 
 struct input_t {
@@ -132,20 +133,15 @@ int64_t part2(input_t input)
     return *max - *min;
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 14\n");
+const aoc::solver_registrar registrar{
+    2021,
+    14,
+    [](std::istream& input) { return part1(read_input(input)); },
+    [](std::istream& input) { return part2(read_input(input)); }};
 
-    std::ifstream ifs{"puzzle.in"};
-    auto          input = read_input(ifs);
-
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2(input));
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
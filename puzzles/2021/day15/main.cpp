@@ -1,75 +1,67 @@
-#include <aoc/aoc.hpp>
+#include <aoc/grid.hpp>
+#include <aoc/runner.hpp>
+#include <aoc/trace.hpp>
 
-#include <glm/vec2.hpp>
-
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
+#include <cstdint>
 #include <deque>
-#include <fstream>
+#include <limits>
+#include <string_view>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 namespace ra = ranges::actions;
 
-using cave_t = std::vector<std::vector<uint8_t>>;
+namespace {
+
+using cave_t = aoc::grid<uint8_t>;
 
-cave_t read_input(std::istream& input)
+cave_t read_input(std::string_view input)
 {
-    return rs::getlines(input) | rv::transform([](auto&& s) {
-               return s | rv::transform([](char c) { return static_cast<uint8_t>(c - '0'); })
-                      | rs::to<std::vector>;
-           })
-           | rs::to<std::vector>;
-}
+    AOC_TRACE_SCOPE("2021/day15/parse");
 
-struct path_t {
-    std::vector<glm::ivec2> steps;
-    int                     min_risk = 0;
-};
+    return cave_t::parse(input, [](char c) { return static_cast<uint8_t>(c - '0'); });
+}
 
 size_t least_path_cost(const cave_t& cave)
 {
-    std::vector<std::vector<size_t>> cost(
-        cave.size(),
-        std::vector<size_t>(cave.size(), std::numeric_limits<size_t>::max()));
-    cost[0][0] = 0;
+    AOC_TRACE_SCOPE("2021/day15/least path cost");
+
+    aoc::grid<size_t> cost(cave.rows(), cave.cols(), std::numeric_limits<size_t>::max());
+    cost(0, 0) = 0;
 
-    std::deque<std::pair<size_t, size_t>> pending;
+    std::deque<aoc::grid_point> pending;
     pending.push_back({0, 0});
 
     while (!pending.empty()) {
-        auto [row, col] = pending.front();
+        AOC_TRACE_SAMPLE("2021/day15/queue length", pending.size());
+
+        auto p = pending.front();
         pending.pop_front();
 
-        if (row > 0 && cost[row][col] + cave[row - 1][col] < cost[row - 1][col]) {
-            cost[row - 1][col] = cost[row][col] + cave[row - 1][col];
-            pending.push_back({row - 1, col});
-        }
-        if (row + 1 < cost.size() && cost[row][col] + cave[row + 1][col] < cost[row + 1][col]) {
-            cost[row + 1][col] = cost[row][col] + cave[row + 1][col];
-            pending.push_back({row + 1, col});
-        }
-        if (col > 0 && cost[row][col] + cave[row][col - 1] < cost[row][col - 1]) {
-            cost[row][col - 1] = cost[row][col] + cave[row][col - 1];
-            pending.push_back({row, col - 1});
-        }
-        if (col + 1 < cost[row].size() && cost[row][col] + cave[row][col + 1] < cost[row][col + 1]) {
-            cost[row][col + 1] = cost[row][col] + cave[row][col + 1];
-            pending.push_back({row, col + 1});
+        for (auto n : cave.neighbors(p, aoc::neighbors_4)) {
+            if (cost[p] + cave[n] < cost[n]) {
+                cost[n] = cost[p] + cave[n];
+                pending.push_back(n);
+
+                AOC_TRACE_COUNT("2021/day15/queue pushes", 1);
+            }
         }
     }
 
-    return cost[cost.size() - 1][cost[cost.size() - 1].size() - 1];
+    return cost(cost.rows() - 1, cost.cols() - 1);
 }
 
 cave_t expand_cave(const cave_t& cave)
 {
-    const size_t dim = cave.size();
-    cave_t       result(dim * 5, std::vector<uint8_t>(dim * 5, 0));
-    for (size_t i = 0; i < result.size(); i++) {
-        for (size_t j = 0; j < result[i].size(); j++) {
-            result[i][j] = (((cave[i % dim][j % dim] + i / dim + j / dim) - 1) % 9) + 1;
+    const size_t dim = cave.rows();
+    cave_t       result(dim * 5, dim * 5);
+    for (size_t i = 0; i < result.rows(); i++) {
+        auto row = result.row(i);
+        for (size_t j = 0; j < row.size(); j++) {
+            auto risk = cave.row(i % dim)[j % dim] + i / dim + j / dim;
+            row[j]    = static_cast<uint8_t>(((risk - 1) % 9) + 1);
         }
     }
     return result;
@@ -86,29 +78,21 @@ size_t part2(const cave_t& input)
     return least_path_cost(big_cave);
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 15\n");
-
-    std::ifstream ifs{"puzzle.in"};
+const aoc::solver_registrar registrar{
+    2021,
+    15,
+    [](std::string_view input) { return part1(read_input(input)); },
+    [](std::string_view input) { return part2(read_input(input)); }};
 
-    auto input = read_input(ifs);
+} // namespace
 
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2(input));
-}
-
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
-#include <sstream>
 
 TEST_CASE("Can solve part 1 example")
 {
-    std::stringstream ss;
-    ss << R"(1163751742
+    auto input = read_input(R"(1163751742
 1381373672
 2136511328
 3694931569
@@ -117,17 +101,14 @@ TEST_CASE("Can solve part 1 example")
 1359912421
 3125421639
 1293138521
-2311944581)";
-
-    auto input = read_input(ss);
+2311944581)");
 
     REQUIRE(40 == part1(input));
 }
 
 TEST_CASE("Can solve part 2 example")
 {
-    std::stringstream ss;
-    ss << R"(1163751742
+    auto input = read_input(R"(1163751742
 1381373672
 2136511328
 3694931569
@@ -136,9 +117,7 @@ TEST_CASE("Can solve part 2 example")
 1359912421
 3125421639
 1293138521
-2311944581)";
-
-    auto input = read_input(ss);
+2311944581)");
 
     REQUIRE(315 == part2(input));
 }
@@ -1,10 +1,9 @@
 #include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
 #include <coroutine>
-#include <fstream>
 #include <numeric>
 #include <optional>
 #include <variant>
@@ -13,6 +12,7 @@ namespace rs = ranges;
 namespace rv = ranges::views;
 namespace ra = ranges::actions;
 
+namespace {
 
 template <std::movable T>
 class Generator {
@@ -377,23 +377,25 @@ uint64_t part2(const Packet::Packet& packet)
     return static_cast<uint64_t>(packet);
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 16\n");
-
-    std::ifstream ifs{"puzzle.in"};
-
-    BitStream      stream(ifs);
-    Packet::Packet packet;
-    stream >> packet;
-
-    fmt::print("Part 1 Solution: {}\n", part1(packet));
-    fmt::print("Part 2 Solution: {}\n", part2(packet));
-}
-
-#else
+const aoc::solver_registrar registrar{
+    2021,
+    16,
+    [](std::istream& input) {
+        BitStream      stream(input);
+        Packet::Packet packet;
+        stream >> packet;
+        return part1(packet);
+    },
+    [](std::istream& input) {
+        BitStream      stream(input);
+        Packet::Packet packet;
+        stream >> packet;
+        return part2(packet);
+    }};
+
+} // namespace
+
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
@@ -1,14 +1,14 @@
 #include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
-#include <fstream>
-
 namespace rs = ranges;
 namespace rv = ranges::views;
 namespace ra = ranges::actions;
 
+namespace {
+
 int find_max_y(int y_min)
 {
     auto ypos_func = [](int steps, int y_start) { return steps * y_start - steps * (steps - 1) / 2; };
@@ -53,19 +53,15 @@ int part2(int x_min, int x_max, int y_min, int y_max)
     return cnt;
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 17\n");
-
-    std::ifstream ifs{"puzzle.in"};
+const aoc::solver_registrar registrar{
+    2021,
+    17,
+    [](std::istream&) { return part1(-103); },
+    [](std::istream&) { return part2(265, 287, -103, -58); }};
 
-    fmt::print("Part 1 Solution: {}\n", part1(-103));
-    fmt::print("Part 2 Solution: {}\n", part2(265, 287, -103, -58));
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
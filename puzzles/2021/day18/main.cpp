@@ -1,9 +1,8 @@
 #include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
-#include <fstream>
 #include <numeric>
 #include <optional>
 
@@ -11,6 +10,8 @@ namespace rs = ranges;
 namespace rv = ranges::views;
 namespace ra = ranges::actions;
 
+namespace {
+
 struct SnailNumber {
     SnailNumber()              = default;
     SnailNumber(SnailNumber&&) = default;
@@ -169,6 +170,14 @@ bool SnailNumber::lr_search(
     return false;
 }
 
+std::vector<SnailNumber> read_input(std::istream& input)
+{
+    std::vector<SnailNumber> numbers;
+    rs::copy(rs::istream_view<SnailNumber>(input), std::back_inserter(numbers));
+
+    return numbers;
+}
+
 uint64_t part1(std::vector<SnailNumber> numbers)
 {
     SnailNumber sum = std::accumulate(numbers.begin() + 1, numbers.end(), numbers[0], std::plus<>());
@@ -203,21 +212,15 @@ uint64_t part2(std::vector<SnailNumber> numbers)
     return best;
 }
 
-#ifndef UNIT_TESTING
+const aoc::solver_registrar registrar{
+    2021,
+    18,
+    [](std::istream& input) { return part1(read_input(input)); },
+    [](std::istream& input) { return part2(read_input(input)); }};
 
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 18\n");
-
-    std::ifstream            ifs{"puzzle.in"};
-    std::vector<SnailNumber> numbers;
-    rs::copy(rs::istream_view<SnailNumber>(ifs), std::back_inserter(numbers));
-
-    fmt::print("Part 1 Solution: {}\n", part1(numbers));
-    fmt::print("Part 2 Solution: {}\n", part2(numbers));
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
@@ -1,11 +1,10 @@
 #include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <glm/vec3.hpp>
 #include <range/v3/all.hpp>
 
 #include <deque>
-#include <fstream>
 #include <optional>
 #include <sstream>
 #include <unordered_set>
@@ -14,6 +13,7 @@ namespace rs = ranges;
 namespace rv = ranges::views;
 namespace ra = ranges::actions;
 
+namespace {
 
 using Rotation                 = std::array<std::pair<int, int>, 3>;
 inline const constexpr int X   = 0;
@@ -56,6 +56,8 @@ struct Point3D {
     friend auto          operator<=>(const Point3D&, const Point3D&) = default;
 };
 
+} // namespace
+
 template <>
 struct std::hash<Point3D> {
     std::size_t operator()(Point3D const& s) const noexcept
@@ -67,6 +69,8 @@ struct std::hash<Point3D> {
     }
 };
 
+namespace {
+
 std::istream& operator>>(std::istream& s, Point3D& b)
 {
     char delim;
@@ -236,20 +240,15 @@ int64_t part2(const std::vector<Scanner>& scanners)
     return best;
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 19\n");
-
-    std::ifstream ifs{"puzzle.in"};
-    auto          input = read_input(ifs);
+const aoc::solver_registrar registrar{
+    2021,
+    19,
+    [](std::istream& input) { return part1(read_input(input)); },
+    [](std::istream& input) { return part2(read_input(input)); }};
 
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2(input));
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
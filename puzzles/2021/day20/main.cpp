@@ -1,16 +1,17 @@
 #include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
 #include <algorithm>
-#include <fstream>
 #include <ranges>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 namespace ra = ranges::actions;
 
+namespace {
+
 struct Image {
     std::vector<bool>              decoder;
     std::vector<std::vector<bool>> data;
@@ -101,22 +102,23 @@ uint64_t part2(Image input)
     return input.lit_pixels();
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 20\n");
-
-    std::ifstream ifs{"puzzle.in"};
-
-    Image input;
-    ifs >> input;
-
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2(input));
-}
-
-#else
+const aoc::solver_registrar registrar{
+    2021,
+    20,
+    [](std::istream& input) {
+        Image image;
+        input >> image;
+        return part1(image);
+    },
+    [](std::istream& input) {
+        Image image;
+        input >> image;
+        return part2(image);
+    }};
+
+} // namespace
+
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
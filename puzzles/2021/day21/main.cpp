@@ -1,14 +1,14 @@
 #include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
-#include <fstream>
-
 namespace rs = ranges;
 namespace rv = ranges::views;
 namespace ra = ranges::actions;
 
+namespace {
+
 std::unordered_map<uint32_t, uint32_t> distribution
     = {{3, 1}, {4, 3}, {5, 6}, {6, 7}, {7, 6}, {8, 3}, {9, 1}};
 
@@ -19,6 +19,8 @@ struct pawn_t {
     friend auto operator<=>(const pawn_t&, const pawn_t&) = default;
 };
 
+} // namespace
+
 template <>
 struct std::hash<pawn_t> {
     std::size_t operator()(pawn_t const& p) const noexcept
@@ -29,6 +31,8 @@ struct std::hash<pawn_t> {
     }
 };
 
+namespace {
+
 struct state_t {
     pawn_t player1 = {};
     pawn_t player2 = {};
@@ -36,6 +40,7 @@ struct state_t {
     friend auto operator<=>(const state_t&, const state_t&) = default;
 };
 
+} // namespace
 
 template <>
 struct std::hash<state_t> {
@@ -47,6 +52,8 @@ struct std::hash<state_t> {
     }
 };
 
+namespace {
+
 struct game_t {
     state_t state;
 
@@ -162,20 +169,15 @@ uint64_t part2(game_t game)
     return std::max(p1, p2);
 }
 
-#ifndef UNIT_TESTING
+const aoc::solver_registrar registrar{
+    2021,
+    21,
+    [](std::istream& input) { return part1(game_t{input}); },
+    [](std::istream& input) { return part2(game_t{input}); }};
 
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 21\n");
-
-    std::ifstream ifs{"puzzle.in"};
-    game_t        game{ifs};
-
-    fmt::print("Part 1 Solution: {}\n", part1(game));
-    fmt::print("Part 2 Solution: {}\n", part2(game));
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
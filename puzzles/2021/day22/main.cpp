@@ -1,11 +1,10 @@
 #include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
 #include <boost/multi_array.hpp>
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
 #include <algorithm>
-#include <fstream>
 #include <numeric>
 #include <optional>
 #include <set>
@@ -14,6 +13,7 @@ namespace rs = ranges;
 namespace rv = ranges::views;
 namespace ra = ranges::actions;
 
+namespace {
 
 struct cuboid {
     bool on;
@@ -141,21 +141,15 @@ int64_t part2(const std::vector<cuboid>& full_input)
     return do_cube_ops(full_input);
 }
 
-#ifndef UNIT_TESTING
+const aoc::solver_registrar registrar{
+    2021,
+    22,
+    [](std::istream& input) { return part1(parse_cube_ops(rs::getlines(input) | rs::to<std::vector>)); },
+    [](std::istream& input) { return part2(parse_cube_ops(rs::getlines(input) | rs::to<std::vector>)); }};
 
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 22\n");
-
-    std::ifstream ifs{"puzzle.in"};
-
-    auto input = parse_cube_ops(rs::getlines(ifs) | rs::to<std::vector>);
-
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2(input));
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
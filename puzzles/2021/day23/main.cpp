@@ -1,15 +1,16 @@
 #include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
-#include <fstream>
 #include <optional>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 namespace ra = ranges::actions;
 
+namespace {
+
 const inline std::unordered_map<char, std::size_t> COST = {{'A', 1}, {'B', 10}, {'C', 100}, {'D', 1000}};
 
 struct Room {
@@ -230,31 +231,31 @@ size_t part2(Puzzle input)
     return find_shortest(input).value();
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 23\n");
-
-    std::ifstream ifs{"puzzle.in"};
-    Puzzle        in1{
-               .hallway = {'.', '.', '.', '.', '.', '.', '.', '.', '.', '.', '.'},
-               .rooms   = {{'A', {'B', 'D'}}, {'B', {'A', 'D'}}, {'C', {'B', 'C'}}, {'D', {'A', 'C'}}}};
-
-    fmt::print("Part 1 Solution: {}\n", part1(in1));
-
-    Puzzle in2{
-        .hallway = {'.', '.', '.', '.', '.', '.', '.', '.', '.', '.', '.'},
-        .rooms   = {
-            {'A', {'B', 'D', 'D', 'D'}},
-            {'B', {'A', 'B', 'C', 'D'}},
-            {'C', {'B', 'A', 'B', 'C'}},
-            {'D', {'A', 'C', 'A', 'C'}}}};
-
-    fmt::print("Part 2 Solution: {}\n", part2(in2));
-}
-
-#else
+const aoc::solver_registrar registrar{
+    2021,
+    23,
+    [](std::istream&) {
+        Puzzle in1{
+            .hallway = {'.', '.', '.', '.', '.', '.', '.', '.', '.', '.', '.'},
+            .rooms   = {{'A', {'B', 'D'}}, {'B', {'A', 'D'}}, {'C', {'B', 'C'}}, {'D', {'A', 'C'}}}};
+
+        return part1(in1);
+    },
+    [](std::istream&) {
+        Puzzle in2{
+            .hallway = {'.', '.', '.', '.', '.', '.', '.', '.', '.', '.', '.'},
+            .rooms   = {
+                {'A', {'B', 'D', 'D', 'D'}},
+                {'B', {'A', 'B', 'C', 'D'}},
+                {'C', {'B', 'A', 'B', 'C'}},
+                {'D', {'A', 'C', 'A', 'C'}}}};
+
+        return part2(in2);
+    }};
+
+} // namespace
+
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
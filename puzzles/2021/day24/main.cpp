@@ -1,14 +1,49 @@
 #include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
-#include <fstream>
+#include <string>
+#include <tuple>
+#include <vector>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 namespace ra = ranges::actions;
 
+namespace {
+
+std::tuple<std::vector<int32_t>, std::vector<int32_t>, std::vector<int32_t>> read_input(std::istream& input)
+{
+    std::vector<int32_t> divisors;
+    std::vector<int32_t> offsets;
+    std::vector<int32_t> modifiers;
+
+    std::string line;
+    size_t      block_id = 0;
+    size_t      line_id  = 0;
+    while (std::getline(input, line)) {
+        if (line_id == 4) {
+            int32_t val = std::stol(line.substr(6));
+            divisors.push_back(val);
+        }
+        if (line_id == 5) {
+            int32_t val = std::stol(line.substr(6));
+            offsets.push_back(val);
+        }
+        if (line_id == 15) {
+            int32_t val = std::stol(line.substr(6));
+            modifiers.push_back(val);
+        }
+
+        line_id++;
+        block_id += line_id / 18;
+        line_id %= 18;
+    }
+
+    return {divisors, offsets, modifiers};
+}
+
 int64_t search(
     std::vector<int32_t>& divisors,
     std::vector<int32_t>& offsets,
@@ -46,45 +81,21 @@ part2(std::vector<int32_t> divisors, std::vector<int32_t> offsets, std::vector<i
     return search(divisors, offsets, modifiers, [](uint64_t a, uint64_t b) { return std::min(a, b); });
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 24\n");
-
-    std::ifstream ifs{"puzzle.in"};
-
-    std::vector<int32_t> divisors;
-    std::vector<int32_t> offsets;
-    std::vector<int32_t> modifiers;
-
-    std::string line;
-    size_t      block_id = 0;
-    size_t      line_id  = 0;
-    while (std::getline(ifs, line)) {
-        if (line_id == 4) {
-            int32_t val = std::stol(line.substr(6));
-            divisors.push_back(val);
-        }
-        if (line_id == 5) {
-            int32_t val = std::stol(line.substr(6));
-            offsets.push_back(val);
-        }
-        if (line_id == 15) {
-            int32_t val = std::stol(line.substr(6));
-            modifiers.push_back(val);
-        }
-
-        line_id++;
-        block_id += line_id / 18;
-        line_id %= 18;
-    }
-
-    fmt::print("Part 1 Solution: {}\n", part1(divisors, offsets, modifiers));
-    fmt::print("Part 2 Solution: {}\n", part2(divisors, offsets, modifiers));
-}
-
-#else
+const aoc::solver_registrar registrar{
+    2021,
+    24,
+    [](std::istream& input) {
+        auto [divisors, offsets, modifiers] = read_input(input);
+        return part1(divisors, offsets, modifiers);
+    },
+    [](std::istream& input) {
+        auto [divisors, offsets, modifiers] = read_input(input);
+        return part2(divisors, offsets, modifiers);
+    }};
+
+} // namespace
+
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
@@ -1,26 +1,28 @@
-#include <aoc/aoc.hpp>
+#include <aoc/grid.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
-#include <fstream>
+#include <cstddef>
+#include <string_view>
 
 namespace rs = ranges;
 namespace rv = ranges::views;
 namespace ra = ranges::actions;
 
-using map_t = std::vector<std::vector<char>>;
+namespace {
 
-map_t read_input(std::istream& input)
+using map_t = aoc::grid<char>;
+
+map_t read_input(std::string_view input)
 {
-    return rs::getlines(input) | rv::transform([](auto&& r) { return r | rs::to<std::vector>; })
-           | rs::to<std::vector>;
+    return map_t::parse(input, [](char c) { return c; });
 }
 
-bool has_moves(const std::vector<std::vector<bool>>& potentials)
+bool has_moves(const aoc::grid<char>& potentials)
 {
-    for (const auto& p : potentials) {
-        if (rs::any_of(p, [](bool v) { return v; })) { return true; }
+    for (std::size_t y = 0; y < potentials.rows(); ++y) {
+        if (rs::any_of(potentials.row(y), [](char v) { return v; })) { return true; }
     }
     return false;
 }
@@ -29,70 +31,53 @@ int part1(map_t input)
 {
     int steps = 0;
 
-    std::vector<std::vector<bool>> east_moves(input.size(), std::vector<bool>(input[0].size(), false));
-    std::vector<std::vector<bool>> south_moves(input.size(), std::vector<bool>(input[0].size(), false));
+    const std::ptrdiff_t height = static_cast<std::ptrdiff_t>(input.rows());
+    const std::ptrdiff_t width  = static_cast<std::ptrdiff_t>(input.cols());
+
+    aoc::grid<char> east_moves(input.rows(), input.cols(), false);
+    aoc::grid<char> south_moves(input.rows(), input.cols(), false);
 
     do {
         ++steps;
 
-        east_moves = std::vector<std::vector<bool>>(
-            input.size(),
-            std::vector<bool>(input[0].size(), false));
-        south_moves = std::vector<std::vector<bool>>(
-            input.size(),
-            std::vector<bool>(input[0].size(), false));
+        east_moves.fill(false);
+        south_moves.fill(false);
 
         // check east moves
-        for (int y = 0; y < input.size(); ++y) {
-            for (int x = 0; x < input[0].size(); ++x) {
-                if (input[y][x] != '>') continue;
-                if (x == input[0].size() - 1) { east_moves[y][x] = input[y][0] == '.'; }
-                else {
-                    east_moves[y][x] = input[y][x + 1] == '.';
-                }
+        for (std::ptrdiff_t y = 0; y < height; ++y) {
+            for (std::ptrdiff_t x = 0; x < width; ++x) {
+                if (input(y, x) != '>') continue;
+                east_moves(y, x) = input(y, (x + 1) % width) == '.';
             }
         }
 
         // move east
-        for (int y = 0; y < input.size(); ++y) {
-            for (int x = 0; x < input[0].size(); ++x) {
-                if (east_moves[y][x]) {
-                    input[y][x] = '.';
-
-                    if (x == input[0].size() - 1) { input[y][0] = '>'; }
-                    else {
-                        input[y][x + 1] = '>';
-                    }
+        for (std::ptrdiff_t y = 0; y < height; ++y) {
+            for (std::ptrdiff_t x = 0; x < width; ++x) {
+                if (east_moves(y, x)) {
+                    input(y, x)               = '.';
+                    input(y, (x + 1) % width) = '>';
                 }
             }
         }
 
         // check south moves
-        for (int y = 0; y < input.size(); ++y) {
-            for (int x = 0; x < input[0].size(); ++x) {
-                if (input[y][x] != 'v') continue;
-                if (y == input.size() - 1) { south_moves[y][x] = input[0][x] == '.'; }
-                else {
-                    south_moves[y][x] = input[y + 1][x] == '.';
-                }
+        for (std::ptrdiff_t y = 0; y < height; ++y) {
+            for (std::ptrdiff_t x = 0; x < width; ++x) {
+                if (input(y, x) != 'v') continue;
+                south_moves(y, x) = input((y + 1) % height, x) == '.';
             }
         }
 
         // move south
-        for (int y = 0; y < input.size(); ++y) {
-            for (int x = 0; x < input[0].size(); ++x) {
-                if (south_moves[y][x]) {
-                    input[y][x] = '.';
-
-                    if (y == input.size() - 1) { input[0][x] = 'v'; }
-                    else {
-                        input[y + 1][x] = 'v';
-                    }
+        for (std::ptrdiff_t y = 0; y < height; ++y) {
+            for (std::ptrdiff_t x = 0; x < width; ++x) {
+                if (south_moves(y, x)) {
+                    input(y, x)                = '.';
+                    input((y + 1) % height, x) = 'v';
                 }
             }
         }
-
-
     } while (has_moves(east_moves) || has_moves(south_moves));
 
     return steps;
@@ -103,29 +88,21 @@ int part2()
     return 0;
 }
 
-#ifndef UNIT_TESTING
+const aoc::solver_registrar registrar{
+    2021,
+    25,
+    [](std::string_view input) { return part1(read_input(input)); },
+    [](std::string_view) { return part2(); }};
 
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day 25\n");
+} // namespace
 
-    std::ifstream ifs{"puzzle.in"};
-
-    auto input = read_input(ifs);
-
-    fmt::print("Part 1 Solution: {}\n", part1(input));
-    fmt::print("Part 2 Solution: {}\n", part2());
-}
-
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
-#include <sstream>
 
 TEST_CASE("Can solve part 1 example")
 {
-    std::stringstream ss;
-    ss << R"(v...>>.vv>
+    auto input = read_input(R"(v...>>.vv>
 .vv>>.vv..
 >>.>v>...v
 >>v>>.>.v.
@@ -133,18 +110,13 @@ v>v.vv.v..
 >.>>..v...
 .vv..>.>v.
 v.v..>>v.v
-....v..v.>)";
-
-    auto input = read_input(ss);
+....v..v.>)");
 
     REQUIRE(58 == part1(input));
 }
 
 TEST_CASE("Can solve part 2 example")
 {
-    std::stringstream ss;
-    ss << R"()";
-
     REQUIRE(0 == part2());
 }
 
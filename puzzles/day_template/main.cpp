@@ -1,14 +1,14 @@
 #include <aoc/aoc.hpp>
+#include <aoc/runner.hpp>
 
-#include <fmt/core.h>
 #include <range/v3/all.hpp>
 
-#include <fstream>
-
 namespace rs = ranges;
 namespace rv = ranges::views;
 namespace ra = ranges::actions;
 
+namespace {
+
 int part1()
 {
     return 0;
@@ -19,19 +19,15 @@ int part2()
     return 0;
 }
 
-#ifndef UNIT_TESTING
-
-int main()
-{
-    fmt::print("Advent of Code 2021 - Day XX\n");
-
-    std::ifstream ifs{"puzzle.in"};
+const aoc::solver_registrar registrar{
+    2021,
+    0,
+    [](std::istream&) { return part1(); },
+    [](std::istream&) { return part2(); }};
 
-    fmt::print("Part 1 Solution: {}\n", part1());
-    fmt::print("Part 2 Solution: {}\n", part2());
-}
+} // namespace
 
-#else
+#ifdef UNIT_TESTING
 
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
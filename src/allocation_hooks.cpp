@@ -0,0 +1,122 @@
+// Counting replacements for the global allocation functions plus a Catch2 listener that reports what
+// every TEST_CASE allocated. Only linked into test binaries when AOC_TRACK_ALLOCATIONS is ON.
+
+#include <aoc/allocations.hpp>
+
+#include <catch2/catch_test_case_info.hpp>
+#include <catch2/reporters/catch_reporter_event_listener.hpp>
+#include <catch2/reporters/catch_reporter_registrars.hpp>
+#include <fmt/format.h>
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+void* allocate(std::size_t size)
+{
+    aoc::allocations::record(size);
+
+    if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+
+    throw std::bad_alloc{};
+}
+
+void* allocate(std::size_t size, std::align_val_t alignment)
+{
+    aoc::allocations::record(size);
+
+    auto align = static_cast<std::size_t>(alignment);
+    size       = (size + align - 1) / align * align;
+
+#ifdef _WIN32
+    if (void* p = _aligned_malloc(size == 0 ? align : size, align)) return p;
+#else
+    if (void* p = std::aligned_alloc(align, size == 0 ? align : size)) return p;
+#endif
+
+    throw std::bad_alloc{};
+}
+
+void deallocate(void* p) noexcept
+{
+    std::free(p);
+}
+
+void deallocate(void* p, std::align_val_t) noexcept
+{
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+class allocation_listener : public Catch::EventListenerBase {
+public:
+    using Catch::EventListenerBase::EventListenerBase;
+
+    void testCaseStarting(const Catch::TestCaseInfo&) override { aoc::allocations::mark_test_start(); }
+
+    void testCaseEnded(const Catch::TestCaseStats& stats) override
+    {
+        auto used = aoc::allocations::since_test_start();
+
+        fmt::print(
+            "[allocations] {}: {} allocation(s), {} byte(s)\n",
+            stats.testInfo->name,
+            used.count,
+            used.bytes);
+    }
+};
+
+} // namespace
+
+CATCH_REGISTER_LISTENER(allocation_listener)
+
+// clang-format off
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t al) { return allocate(size, al); }
+void* operator new[](std::size_t size, std::align_val_t al) { return allocate(size, al); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try { return allocate(size); } catch (...) { return nullptr; }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    try { return allocate(size); } catch (...) { return nullptr; }
+}
+
+void* operator new(std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept
+{
+    try { return allocate(size, al); } catch (...) { return nullptr; }
+}
+
+void* operator new[](std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept
+{
+    try { return allocate(size, al); } catch (...) { return nullptr; }
+}
+
+void operator delete(void* p) noexcept { deallocate(p); }
+void operator delete[](void* p) noexcept { deallocate(p); }
+void operator delete(void* p, std::size_t) noexcept { deallocate(p); }
+void operator delete[](void* p, std::size_t) noexcept { deallocate(p); }
+void operator delete(void* p, std::align_val_t al) noexcept { deallocate(p, al); }
+void operator delete[](void* p, std::align_val_t al) noexcept { deallocate(p, al); }
+void operator delete(void* p, std::size_t, std::align_val_t al) noexcept { deallocate(p, al); }
+void operator delete[](void* p, std::size_t, std::align_val_t al) noexcept { deallocate(p, al); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { deallocate(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { deallocate(p); }
+void operator delete(void* p, std::align_val_t al, const std::nothrow_t&) noexcept
+{
+    deallocate(p, al);
+}
+
+void operator delete[](void* p, std::align_val_t al, const std::nothrow_t&) noexcept
+{
+    deallocate(p, al);
+}
+// clang-format on
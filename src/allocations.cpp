@@ -0,0 +1,40 @@
+
+#include "allocations.hpp"
+
+#include <atomic>
+
+namespace aoc::allocations {
+
+namespace {
+
+    std::atomic<std::uint64_t> allocation_count = 0;
+    std::atomic<std::uint64_t> allocated_bytes  = 0;
+
+    stats test_start;
+
+} // namespace
+
+void record(std::size_t bytes) noexcept
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+stats totals() noexcept
+{
+    return {
+        allocation_count.load(std::memory_order_relaxed),
+        allocated_bytes.load(std::memory_order_relaxed)};
+}
+
+void mark_test_start() noexcept
+{
+    test_start = totals();
+}
+
+stats since_test_start() noexcept
+{
+    return totals() - test_start;
+}
+
+} // namespace aoc::allocations
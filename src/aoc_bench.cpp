@@ -0,0 +1,349 @@
+#include <aoc/input.hpp>
+#include <aoc/intcode.hpp>
+#include <aoc/intcode_network.hpp>
+#include <aoc/runner.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_version_macros.hpp>
+#include <catch2/reporters/catch_reporter_event_listener.hpp>
+#include <catch2/reporters/catch_reporter_registrars.hpp>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#ifndef AOC_PUZZLES_DIR
+#define AOC_PUZZLES_DIR "."
+#endif
+
+namespace {
+
+#if CATCH_VERSION_MAJOR > 3 || (CATCH_VERSION_MAJOR == 3 && CATCH_VERSION_MINOR >= 5)
+using benchmark_stats = Catch::BenchmarkStats;
+#else
+using benchmark_stats = Catch::BenchmarkStats<>;
+#endif
+
+struct bench_options {
+    std::string input_dir = AOC_PUZZLES_DIR;
+    int         year      = 0;
+    int         day       = 0;
+    int         part      = 0;
+    std::string csv_path;
+    std::string json_path;
+};
+
+bench_options options;
+
+// Operations one iteration of a benchmark performs, for reporting throughput next to its timings.
+std::map<std::string, std::uint64_t> operations_per_iteration;
+
+struct bench_result {
+    std::string name;
+    std::size_t samples;
+    int         iterations;
+    double      mean_ns;
+    double      mean_low_ns;
+    double      mean_high_ns;
+    double      std_dev_ns;
+    double      min_ns;
+    double      median_ns;
+    double      max_ns;
+    double      outlier_variance;
+    double      ops_per_second;
+};
+
+bool is_selected(const aoc::solver_entry& solver)
+{
+    return (options.year == 0 || options.year == solver.year) && (options.day == 0 || options.day == solver.day)
+           && (options.part == 0 || options.part == solver.part);
+}
+
+void write_csv(const std::string& path, const std::vector<bench_result>& results)
+{
+    std::ofstream ofs{path};
+
+    ofs << "name,samples,iterations,mean_ns,mean_low_ns,mean_high_ns,std_dev_ns,min_ns,median_ns,max_ns,"
+           "outlier_variance,ops_per_second\n";
+
+    for (const auto& r : results) {
+        ofs << fmt::format(
+            "{},{},{},{:.1f},{:.1f},{:.1f},{:.1f},{:.1f},{:.1f},{:.1f},{:.4f},{:.0f}\n",
+            r.name,
+            r.samples,
+            r.iterations,
+            r.mean_ns,
+            r.mean_low_ns,
+            r.mean_high_ns,
+            r.std_dev_ns,
+            r.min_ns,
+            r.median_ns,
+            r.max_ns,
+            r.outlier_variance,
+            r.ops_per_second);
+    }
+}
+
+void write_json(const std::string& path, const std::vector<bench_result>& results)
+{
+    std::ofstream ofs{path};
+
+    ofs << "{\n  \"benchmarks\": [";
+
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+
+        ofs << (i == 0 ? "\n" : ",\n")
+            << fmt::format(
+                   R"(    {{"name": "{}", "samples": {}, "iterations": {}, "mean_ns": {:.1f}, )"
+                   R"("mean_low_ns": {:.1f}, "mean_high_ns": {:.1f}, "std_dev_ns": {:.1f}, "min_ns": {:.1f}, )"
+                   R"("median_ns": {:.1f}, "max_ns": {:.1f}, "outlier_variance": {:.4f}, )"
+                   R"("ops_per_second": {:.0f}}})",
+                   r.name,
+                   r.samples,
+                   r.iterations,
+                   r.mean_ns,
+                   r.mean_low_ns,
+                   r.mean_high_ns,
+                   r.std_dev_ns,
+                   r.min_ns,
+                   r.median_ns,
+                   r.max_ns,
+                   r.outlier_variance,
+                   r.ops_per_second);
+    }
+
+    ofs << "\n  ]\n}\n";
+}
+
+// Collects every finished benchmark so the run can be exported for regression tracking.
+class export_listener : public Catch::EventListenerBase {
+public:
+    using Catch::EventListenerBase::EventListenerBase;
+
+    void benchmarkEnded(const benchmark_stats& stats) override
+    {
+        std::vector<double> samples;
+        for (const auto& sample : stats.samples) {
+            samples.push_back(sample.count());
+        }
+
+        std::sort(samples.begin(), samples.end());
+
+        double ops_per_second = 0.0;
+        if (auto it = operations_per_iteration.find(stats.info.name);
+            it != operations_per_iteration.end() && stats.mean.point.count() > 0) {
+            ops_per_second = static_cast<double>(it->second) / stats.mean.point.count() * 1e9;
+
+            fmt::print("{}: {:.1f} M ops/s\n", stats.info.name, ops_per_second / 1e6);
+        }
+
+        results_.push_back(
+            {.name             = stats.info.name,
+             .samples          = samples.size(),
+             .iterations       = stats.info.iterations,
+             .mean_ns          = stats.mean.point.count(),
+             .mean_low_ns      = stats.mean.lower_bound.count(),
+             .mean_high_ns     = stats.mean.upper_bound.count(),
+             .std_dev_ns       = stats.standardDeviation.point.count(),
+             .min_ns           = samples.empty() ? 0.0 : samples.front(),
+             .median_ns        = samples.empty() ? 0.0 : samples[samples.size() / 2],
+             .max_ns           = samples.empty() ? 0.0 : samples.back(),
+             .outlier_variance = stats.outlierVariance,
+             .ops_per_second   = ops_per_second});
+    }
+
+    void testRunEnded(const Catch::TestRunStats&) override
+    {
+        if (!options.csv_path.empty()) { write_csv(options.csv_path, results_); }
+        if (!options.json_path.empty()) { write_json(options.json_path, results_); }
+    }
+
+private:
+    std::vector<bench_result> results_;
+};
+
+} // namespace
+
+CATCH_REGISTER_LISTENER(export_listener)
+
+TEST_CASE("Benchmark registered solvers on puzzle inputs", "[benchmark]")
+{
+    auto solvers = aoc::solver_registry();
+
+    std::stable_sort(solvers.begin(), solvers.end(), [](const auto& a, const auto& b) {
+        return std::tie(a.year, a.day, a.part) < std::tie(b.year, b.day, b.part);
+    });
+
+    std::map<std::pair<int, int>, std::optional<aoc::puzzle_input>> inputs;
+
+    for (const auto& solver : solvers) {
+        if (!is_selected(solver)) continue;
+
+        auto day = std::pair{solver.year, solver.day};
+        if (!inputs.contains(day)) {
+            inputs.emplace(day, aoc::load_puzzle_input(options.input_dir, solver.year, solver.day));
+        }
+
+        const auto& input = inputs[day];
+        if (!input) {
+            FAIL_CHECK(fmt::format("Unable to read puzzle input for {} day {:02}", solver.year, solver.day));
+            continue;
+        }
+
+        auto name = fmt::format("{}/day{:02}/part{}", solver.year, solver.day, solver.part);
+
+        // Throughput of a puzzle part is input lines per second.
+        operations_per_iteration[name] = aoc::count_char(input->contents(), '\n') + 1;
+
+        BENCHMARK(name)
+        {
+            return solver.solve(input->contents());
+        };
+    }
+}
+
+TEST_CASE("Benchmark Intcode engines", "[benchmark][intcode]")
+{
+    using namespace aoc::intcode;
+
+    // Sums the countdown held in cell 100 into cell 101, three instructions per loop.
+    auto program = parse_program("1,101,100,101,1001,100,-1,100,1005,100,0,4,101,99");
+    program.resize(102);
+    program[100] = 1'000'000;
+
+    for (auto selected : {std::pair{"intcode/interpreter", engine::interpreter},
+                          std::pair{"intcode/threaded", engine::threaded},
+                          std::pair{"intcode/jit", engine::jit}}) {
+        auto name   = std::string{selected.first};
+        auto tier   = selected.second;
+
+        vm reference{program, tier};
+        reference.run();
+
+        operations_per_iteration[name] = reference.instructions_executed();
+
+        BENCHMARK(name)
+        {
+            vm machine{program, tier};
+            machine.run();
+            return machine.pop_output();
+        };
+    }
+}
+
+TEST_CASE("Benchmark Intcode snapshots", "[benchmark][intcode]")
+{
+    using namespace aoc::intcode;
+
+    // Forks a machine with 32 pages of memory waiting on input and runs the fork to its next output.
+    auto program = parse_program("3,100,1,100,101,101,4,101,1105,1,0");
+    program.resize(paged_memory::page_size * 32);
+
+    for (auto selected : {std::pair{"intcode/fork-interpreter", engine::interpreter},
+                          std::pair{"intcode/fork-threaded", engine::threaded},
+                          std::pair{"intcode/fork-jit", engine::jit}}) {
+        auto name = std::string{selected.first};
+
+        vm root{program, selected.second};
+        root.run();
+
+        operations_per_iteration[name] = 1;
+
+        BENCHMARK(name)
+        {
+            auto child = root.fork();
+            child.push_input(1);
+            child.run();
+            return child.pop_output();
+        };
+    }
+}
+
+TEST_CASE("Benchmark Intcode networks", "[benchmark][intcode]")
+{
+    using namespace aoc::intcode;
+
+    // Passes a token around a ring of 50 machines, each decrementing it, until it reaches zero.
+    constexpr std::size_t nodes    = 50;
+    constexpr word        messages = 100'000;
+
+    auto relay = parse_program("3,100,1001,100,-1,100,4,100,1005,100,0,99");
+
+    aoc::work_stealing_pool pool;
+
+    for (auto on_pool : {false, true}) {
+        auto name = std::string{on_pool ? "intcode/network-pool" : "intcode/network-cooperative"};
+
+        operations_per_iteration[name] = messages;
+
+        std::chrono::nanoseconds idle_detection{};
+        std::uint64_t            runs = 0;
+
+        BENCHMARK(name)
+        {
+            network ring{[](network& net, std::size_t from, word value) {
+                if (value != 0) net.send((from + 1) % nodes, value);
+            }};
+
+            for (std::size_t i = 0; i < nodes; ++i) {
+                ring.add(relay);
+            }
+
+            ring.send(0, messages);
+
+            if (on_pool) {
+                ring.run(pool);
+            }
+            else {
+                ring.run();
+            }
+
+            idle_detection += ring.stats().idle_detection_latency;
+            ++runs;
+
+            return ring.stats().messages;
+        };
+
+        if (runs > 0) {
+            fmt::print("{}: idle detected {} ns after the last machine parked, mean of {} runs\n",
+                       name,
+                       idle_detection.count() / static_cast<std::int64_t>(runs),
+                       runs);
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Catch::Session session;
+
+    // full puzzle inputs are slow enough that Catch2's default of 100 samples per part is excessive
+    session.configData().benchmarkSamples = 10;
+
+    using Catch::Clara::Opt;
+
+    auto cli = session.cli()
+               | Opt(options.input_dir, "dir")["--input-dir"]("directory holding YYYY/dayNN/puzzle.in")
+               | Opt(options.year, "year")["--year"]("only benchmark this year")
+               | Opt(options.day, "day")["--day"]("only benchmark this day")
+               | Opt(options.part, "part")["--part"]("only benchmark this part")
+               | Opt(options.csv_path, "file")["--csv"]("write benchmark statistics as CSV")
+               | Opt(options.json_path, "file")["--json"]("write benchmark statistics as JSON");
+
+    session.cli(cli);
+
+    if (int rc = session.applyCommandLine(argc, argv); rc != 0) return rc;
+
+    return session.run();
+}
@@ -0,0 +1,307 @@
+#include <aoc/runner.hpp>
+#include <aoc/thread_pool.hpp>
+#include <aoc/trace.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#ifndef AOC_PUZZLES_DIR
+#define AOC_PUZZLES_DIR "."
+#endif
+
+namespace {
+
+struct options {
+    std::optional<int>    year;
+    std::optional<int>    day;
+    std::optional<int>    part;
+    std::filesystem::path input_dir = AOC_PUZZLES_DIR;
+    bool                  parallel  = false;
+    std::size_t           threads   = std::thread::hardware_concurrency();
+    bool                  trace     = false;
+    std::filesystem::path trace_json;
+    bool                  help      = false;
+};
+
+void print_usage(std::string_view program)
+{
+    fmt::print(
+        "Usage: {} [--year YYYY] [--day N] [--part N] [--input-dir DIR] [--parallel [--threads N]]\n"
+        "       [--trace] [--trace-json FILE]\n\n"
+        "Runs every registered solver matching the selectors. Inputs are read from\n"
+        "DIR/YYYY/dayNN/puzzle.in (default: {}), unless the day was built with its\n"
+        "input embedded.\n\n"
+        "With --parallel every selected part is submitted at once to a work-stealing\n"
+        "pool of N threads (default: one per hardware thread).\n\n"
+        "--trace prints the timers, counters and histograms recorded during the run and\n"
+        "--trace-json writes them to FILE. Both need a build with AOC_ENABLE_TRACE=ON.\n",
+        program,
+        AOC_PUZZLES_DIR);
+}
+
+options parse_options(int argc, char* argv[])
+{
+    options opts;
+
+    auto value_of = [&](int& i) -> std::string_view {
+        if (i + 1 >= argc) { throw std::invalid_argument{fmt::format("Missing value for {}", argv[i])}; }
+        return argv[++i];
+    };
+
+    auto int_value_of = [&](int& i) {
+        std::string_view flag = argv[i];
+        std::string      value{value_of(i)};
+        try {
+            return std::stoi(value);
+        }
+        catch (const std::exception&) {
+            throw std::invalid_argument{fmt::format("Invalid value for {}: {}", flag, value)};
+        }
+    };
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+
+        if (arg == "--year") { opts.year = int_value_of(i); }
+        else if (arg == "--day") {
+            opts.day = int_value_of(i);
+        }
+        else if (arg == "--part") {
+            opts.part = int_value_of(i);
+        }
+        else if (arg == "--input-dir") {
+            opts.input_dir = value_of(i);
+        }
+        else if (arg == "--parallel") {
+            opts.parallel = true;
+        }
+        else if (arg == "--threads") {
+            auto threads = int_value_of(i);
+            if (threads < 1) { throw std::invalid_argument{"--threads must be at least 1"}; }
+            opts.threads = static_cast<std::size_t>(threads);
+        }
+        else if (arg == "--trace") {
+            opts.trace = true;
+        }
+        else if (arg == "--trace-json") {
+            opts.trace_json = value_of(i);
+        }
+        else if (arg == "--help" || arg == "-h") {
+            opts.help = true;
+        }
+        else {
+            throw std::invalid_argument{fmt::format("Unknown argument: {}", arg)};
+        }
+    }
+
+    return opts;
+}
+
+bool is_selected(const options& opts, const aoc::solver_entry& solver)
+{
+    return (!opts.year || *opts.year == solver.year) && (!opts.day || *opts.day == solver.day)
+           && (!opts.part || *opts.part == solver.part);
+}
+
+using clock_type = std::chrono::steady_clock;
+
+double to_ms(clock_type::duration d)
+{
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+struct job {
+    const aoc::solver_entry*   solver   = nullptr;
+    const aoc::puzzle_input*   input    = nullptr;
+    std::string                result   = {};
+    std::optional<std::string> error    = {};
+    clock_type::time_point     queued   = {};
+    clock_type::time_point     started  = {};
+    clock_type::time_point     finished = {};
+
+    double wait_ms() const { return to_ms(started - queued); }
+    double run_ms() const { return to_ms(finished - started); }
+};
+
+void run_job(job& j)
+{
+    j.started = clock_type::now();
+
+    if (j.input == nullptr) { j.error = "Unable to read puzzle input"; }
+    else {
+        std::optional<aoc::trace::scoped_timer> part_timer;
+        if (aoc::trace::enabled) {
+            part_timer.emplace(aoc::trace::timer(
+                fmt::format("{}/day{:02}/part{}", j.solver->year, j.solver->day, j.solver->part)));
+        }
+
+        try {
+            j.result = j.solver->solve(j.input->contents());
+        }
+        catch (const std::exception& e) {
+            j.error = e.what();
+        }
+    }
+
+    j.finished = clock_type::now();
+}
+
+void run_sequential(std::vector<job>& jobs)
+{
+    std::optional<std::pair<int, int>> current_day;
+
+    for (auto& j : jobs) {
+        if (current_day != std::pair{j.solver->year, j.solver->day}) {
+            current_day = std::pair{j.solver->year, j.solver->day};
+            fmt::print("Advent of Code {} - Day {:02}\n", j.solver->year, j.solver->day);
+        }
+
+        j.queued = clock_type::now();
+        run_job(j);
+
+        if (j.error) { fmt::print(stderr, "Part {} failed: {}\n", j.solver->part, *j.error); }
+        else {
+            fmt::print("Part {} Solution: {} ({:.3f} ms)\n", j.solver->part, j.result, j.run_ms());
+        }
+    }
+}
+
+void run_parallel(std::vector<job>& jobs, std::size_t threads)
+{
+    aoc::work_stealing_pool pool{threads};
+
+    for (auto& j : jobs) {
+        j.queued = clock_type::now();
+        pool.submit([&j] { run_job(j); });
+    }
+
+    pool.wait();
+
+    for (const auto& j : jobs) {
+        auto label = fmt::format("{} Day {:02} Part {}", j.solver->year, j.solver->day, j.solver->part);
+
+        if (j.error) { fmt::print(stderr, "{} failed: {}\n", label, *j.error); }
+        else {
+            fmt::print(
+                "{}: {} (queued {:.3f} ms, ran {:.3f} ms)\n", label, j.result, j.wait_ms(), j.run_ms());
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    options opts;
+
+    try {
+        opts = parse_options(argc, argv);
+    }
+    catch (const std::invalid_argument& e) {
+        fmt::print(stderr, "{}\n", e.what());
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    if (opts.help) {
+        print_usage(argv[0]);
+        return 0;
+    }
+
+    auto solvers = aoc::solver_registry();
+
+    std::stable_sort(solvers.begin(), solvers.end(), [](const auto& a, const auto& b) {
+        return std::tie(a.year, a.day, a.part) < std::tie(b.year, b.day, b.part);
+    });
+
+    if ((opts.trace || !opts.trace_json.empty()) && !aoc::trace::enabled) {
+        fmt::print(stderr, "Tracing is not compiled in, reconfigure with -DAOC_ENABLE_TRACE=ON\n");
+    }
+
+    std::map<std::pair<int, int>, std::optional<aoc::puzzle_input>> inputs;
+    std::vector<job>                                                 jobs;
+
+    AOC_TRACE_COUNT("runner/registered parts", solvers.size());
+
+    for (const auto& solver : solvers) {
+        AOC_TRACE_SCOPE("runner/map input");
+
+        if (!is_selected(opts, solver)) continue;
+
+        auto day = std::pair{solver.year, solver.day};
+        auto it  = inputs.find(day);
+
+        if (it == inputs.end()) {
+            auto input = aoc::load_puzzle_input(opts.input_dir, solver.year, solver.day);
+            it         = inputs.emplace(day, std::move(input)).first;
+
+            if (!it->second) {
+                fmt::print(
+                    stderr,
+                    "Unable to read puzzle input for {} Day {:02} from {}\n",
+                    solver.year,
+                    solver.day,
+                    opts.input_dir.string());
+            }
+        }
+
+        jobs.push_back({.solver = &solver, .input = it->second ? &*it->second : nullptr});
+    }
+
+    if (jobs.empty()) {
+        fmt::print(stderr, "No registered solvers match the given selectors\n");
+        return 1;
+    }
+
+    auto start = clock_type::now();
+
+    if (opts.parallel) { run_parallel(jobs, opts.threads); }
+    else {
+        run_sequential(jobs);
+    }
+
+    auto wall_ms = to_ms(clock_type::now() - start);
+
+    auto failures = std::ranges::count_if(jobs, [](const job& j) { return j.error.has_value(); });
+    auto solved   = static_cast<std::ptrdiff_t>(jobs.size()) - failures;
+
+    double solver_ms  = 0.0;
+    double longest_ms = 0.0;
+    for (const auto& j : jobs) {
+        solver_ms += j.run_ms();
+        longest_ms = std::max(longest_ms, j.run_ms());
+    }
+
+    fmt::print("\n{} part(s) solved in {:.3f} ms", solved, wall_ms);
+    if (opts.parallel) {
+        fmt::print(
+            " on {} threads ({:.3f} ms of solver time, longest part {:.3f} ms)",
+            opts.threads,
+            solver_ms,
+            longest_ms);
+    }
+    if (failures > 0) { fmt::print(", {} failed", failures); }
+    fmt::print("\n");
+
+    if (opts.trace && aoc::trace::enabled) { fmt::print("\n{}", aoc::trace::report_text()); }
+    if (!opts.trace_json.empty() && aoc::trace::enabled) {
+        std::ofstream ofs{opts.trace_json};
+        ofs << aoc::trace::report_json();
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -4,6 +4,8 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <sstream>
+#include <string>
+#include <vector>
 
 TEST_CASE("Can read a newline delimited list of ints from input")
 {
@@ -45,3 +47,21 @@ TEST_CASE("Can read a character delimited list of ints from input")
     REQUIRE(675 == output[4]);
     REQUIRE(1456 == output[5]);
 }
+
+TEST_CASE("Can materialize a range into an arena")
+{
+    aoc::arena scratch{16};
+
+    std::vector<int> input{3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5};
+
+    auto doubled = input | ranges::views::transform([](int i) { return i * 2; }) | aoc::to_vector(scratch);
+
+    REQUIRE(11 == doubled.size());
+    REQUIRE(18 == doubled[5]);
+    REQUIRE(scratch.resource() == doubled.get_allocator().resource());
+
+    auto word = std::string{"stressed"} | ranges::views::reverse | aoc::to_string(scratch);
+
+    REQUIRE("desserts" == word);
+    REQUIRE(scratch.resource() == word.get_allocator().resource());
+}
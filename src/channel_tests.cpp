@@ -0,0 +1,103 @@
+#include <aoc/channel.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Can pass values through a bounded single producer channel")
+{
+    aoc::spsc_channel<int> channel{3};
+
+    REQUIRE(4 == channel.capacity());
+    REQUIRE(channel.empty());
+    REQUIRE_FALSE(channel.try_pop());
+
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE(channel.try_push(i));
+    }
+
+    REQUIRE_FALSE(channel.try_push(4));
+
+    REQUIRE(0 == channel.try_pop());
+    REQUIRE(channel.try_push(4));
+
+    for (int i = 1; i <= 4; ++i) {
+        REQUIRE(i == channel.try_pop());
+    }
+
+    REQUIRE(channel.empty());
+}
+
+TEST_CASE("Single producer channel keeps order across threads")
+{
+    constexpr std::uint64_t count = 100'000;
+
+    aoc::spsc_channel<std::uint64_t> channel{64};
+
+    std::thread producer{[&channel] {
+        for (std::uint64_t i = 0; i < count; ++i) {
+            while (!channel.try_push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    }};
+
+    std::uint64_t expected = 0;
+    bool          in_order = true;
+
+    while (expected < count) {
+        if (auto value = channel.try_pop()) {
+            in_order = in_order && *value == expected++;
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+
+    REQUIRE(in_order);
+    REQUIRE(channel.empty());
+}
+
+TEST_CASE("Multiple producer channel delivers every value once, in order per producer")
+{
+    constexpr int producers = 4;
+    constexpr int count     = 25'000;
+
+    aoc::mpsc_channel<int> channel;
+    REQUIRE(channel.empty());
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&channel, p] {
+            for (int i = 0; i < count; ++i) {
+                channel.push(p * count + i);
+            }
+        });
+    }
+
+    std::vector<int> next(producers, 0);
+    bool             in_order = true;
+
+    for (int received = 0; received < producers * count;) {
+        if (auto value = channel.try_pop()) {
+            auto p   = *value / count;
+            in_order = in_order && *value % count == next[static_cast<std::size_t>(p)]++;
+            ++received;
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(in_order);
+    REQUIRE(channel.empty());
+    REQUIRE_FALSE(channel.try_pop());
+}
@@ -0,0 +1,82 @@
+#include <aoc/grid.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+int to_digit(char c)
+{
+    return c - '0';
+}
+
+} // namespace
+
+TEST_CASE("Can parse a grid with a padding border")
+{
+    auto grid = aoc::grid<int>::parse("123\n456\n", to_digit, 1, 9);
+
+    REQUIRE(2 == grid.rows());
+    REQUIRE(3 == grid.cols());
+
+    REQUIRE(1 == grid(0, 0));
+    REQUIRE(6 == grid(1, 2));
+    REQUIRE(9 == grid(-1, -1));
+    REQUIRE(9 == grid(2, 3));
+
+    REQUIRE(grid.contains(1, 2));
+    REQUIRE_FALSE(grid.contains(-1, 0));
+
+    REQUIRE(8 == grid.neighbors({0, 0}, aoc::neighbors_8).size());
+
+    REQUIRE_THROWS_AS(grid.at(3, 0), std::out_of_range);
+    REQUIRE_THROWS_AS(aoc::grid<int>::parse("12\n3", to_digit), std::invalid_argument);
+}
+
+TEST_CASE("Can view grid rows, columns and neighbors")
+{
+    auto grid = aoc::grid<int>::parse("123\n456", to_digit);
+
+    REQUIRE(4 == grid.row(1)[0]);
+
+    std::vector<int> column;
+    for (int i : grid.column(1)) {
+        column.push_back(i);
+    }
+
+    REQUIRE(std::vector<int>{2, 5} == column);
+
+    REQUIRE(3 == grid.neighbors({0, 0}, aoc::neighbors_8).size());
+    REQUIRE(3 == grid.neighbors({1, 1}, aoc::neighbors_4).size());
+}
+
+TEST_CASE("Can transpose, rotate and flip a grid")
+{
+    auto grid = aoc::grid<int>::parse("123\n456", to_digit);
+
+    aoc::grid<int> transposed;
+    grid.transpose_into(transposed);
+
+    REQUIRE(aoc::grid<int>::parse("14\n25\n36", to_digit) == transposed);
+
+    aoc::grid<int> rotated;
+    grid.rotate_clockwise_into(rotated);
+
+    REQUIRE(aoc::grid<int>::parse("41\n52\n63", to_digit) == rotated);
+
+    grid.rotate_clockwise();
+    REQUIRE(rotated == grid);
+
+    auto square = aoc::grid<int>::parse("12\n34", to_digit, 1);
+
+    square.transpose();
+    REQUIRE(aoc::grid<int>::parse("13\n24", to_digit, 1) == square);
+
+    square.flip_vertical();
+    REQUIRE(aoc::grid<int>::parse("24\n13", to_digit, 1) == square);
+
+    square.flip_horizontal();
+    REQUIRE(aoc::grid<int>::parse("42\n31", to_digit, 1) == square);
+}
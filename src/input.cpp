@@ -0,0 +1,339 @@
+
+#include "input.hpp"
+
+#include <fmt/format.h>
+
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AOC_HAS_SSE2
+#endif
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace aoc {
+
+namespace {
+
+#if defined(__AVX2__)
+
+    constexpr std::size_t block_size = 32;
+
+    // Bit i is set when p[i] == c, for the block_size bytes starting at p.
+    std::uint32_t match_block(const char* p, char c)
+    {
+        auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(c))));
+    }
+
+#elif defined(AOC_HAS_SSE2)
+
+    constexpr std::size_t block_size = 16;
+
+    std::uint32_t match_block(const char* p, char c)
+    {
+        auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_set1_epi8(c))));
+    }
+
+#else
+
+    constexpr std::size_t block_size = 8;
+
+    std::uint32_t match_block(const char* p, char c)
+    {
+        std::uint32_t mask = 0;
+        for (std::size_t i = 0; i < block_size; ++i) {
+            mask |= static_cast<std::uint32_t>(p[i] == c) << i;
+        }
+
+        return mask;
+    }
+
+#endif
+
+    // Calls f with the position of every c in text, in order.
+    template <typename F>
+    void for_each_match(std::string_view text, char c, F&& f)
+    {
+        std::size_t i = 0;
+
+        for (; i + block_size <= text.size(); i += block_size) {
+            for (auto mask = match_block(text.data() + i, c); mask != 0; mask &= mask - 1) {
+                f(i + static_cast<std::size_t>(std::countr_zero(mask)));
+            }
+        }
+
+        for (; i < text.size(); ++i) {
+            if (text[i] == c) f(i);
+        }
+    }
+
+    bool is_eight_digits(std::uint64_t chunk)
+    {
+        return (((chunk + 0x4646464646464646) | (chunk - 0x3030303030303030)) & 0x8080808080808080) == 0;
+    }
+
+    // Converts eight ASCII digits loaded little endian, most significant digit first, in three multiplies.
+    std::uint32_t parse_eight_digits(std::uint64_t chunk)
+    {
+        chunk -= 0x3030303030303030;
+        chunk = (chunk * 10) + (chunk >> 8);
+        chunk = (((chunk & 0x000000FF000000FF) * (100 + (1000000ULL << 32)))
+                 + (((chunk >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32))))
+                >> 32;
+
+        return static_cast<std::uint32_t>(chunk);
+    }
+
+    template <typename T>
+    T parse_field(std::string_view field)
+    {
+        // fast path for an optional '-' and up to 18 digits, which cannot overflow the accumulator
+        auto digits   = field;
+        bool negative = digits.starts_with('-');
+        if (negative) digits.remove_prefix(1);
+
+        if (digits.empty() || digits.size() > 18) return parse_number<T>(field);
+
+        std::uint64_t value = 0;
+        std::size_t   i     = 0;
+
+        if constexpr (std::endian::native == std::endian::little) {
+            for (; i + 8 <= digits.size(); i += 8) {
+                std::uint64_t chunk;
+                std::memcpy(&chunk, digits.data() + i, sizeof(chunk));
+
+                if (!is_eight_digits(chunk)) return parse_number<T>(field);
+
+                value = value * 100000000 + parse_eight_digits(chunk);
+            }
+        }
+
+        for (; i < digits.size(); ++i) {
+            auto digit = static_cast<unsigned char>(digits[i] - '0');
+            if (digit > 9) return parse_number<T>(field);
+
+            value = value * 10 + digit;
+        }
+
+        auto result = negative ? -static_cast<std::int64_t>(value) : static_cast<std::int64_t>(value);
+
+        // let parse_number report the out of range value
+        if (result < std::numeric_limits<T>::min() || result > std::numeric_limits<T>::max()) {
+            return parse_number<T>(field);
+        }
+
+        return static_cast<T>(result);
+    }
+
+    template <typename T>
+    std::size_t parse_list(std::string_view text, char delimiter, std::span<T> out)
+    {
+        if (text.empty()) return 0;
+
+        std::size_t count = 0;
+        std::size_t start = 0;
+
+        auto parse_until = [&](std::size_t end) {
+            auto field = text.substr(start, end - start);
+            start      = end + 1;
+
+            if (delimiter == '\n') {
+                if (field.ends_with('\r')) field.remove_suffix(1);
+                if (field.empty()) return;
+            }
+
+            if (count == out.size()) { throw std::length_error{"Integer list does not fit the output buffer"}; }
+
+            out[count++] = parse_field<T>(field);
+        };
+
+        for_each_match(text, delimiter, parse_until);
+        parse_until(text.size());
+
+        return count;
+    }
+
+} // namespace
+
+std::size_t count_char(std::string_view text, char c, std::string_view buffer)
+{
+    std::size_t count = 0;
+    std::size_t i     = 0;
+
+    for (; i + block_size <= text.size(); i += block_size) {
+        count += static_cast<std::size_t>(std::popcount(match_block(text.data() + i, c)));
+    }
+
+    if (i == text.size()) return count;
+
+    // One more block for the rest when it still lies inside buffer, ignoring what comes after text.
+    auto rest = text.size() - i;
+    if (static_cast<std::size_t>(buffer.data() + buffer.size() - (text.data() + i)) >= block_size) {
+        auto mask = match_block(text.data() + i, c) & ((std::uint32_t{1} << rest) - 1);
+        return count + static_cast<std::size_t>(std::popcount(mask));
+    }
+
+    for (; i < text.size(); ++i) {
+        if (text[i] == c) ++count;
+    }
+
+    return count;
+}
+
+std::size_t count_char(std::string_view text, char c)
+{
+    return count_char(text, c, text);
+}
+
+std::size_t count_fields(std::string_view text, char delimiter)
+{
+    return text.empty() ? 0 : count_char(text, delimiter) + 1;
+}
+
+std::size_t parse_integer_list(std::string_view text, char delimiter, std::span<std::int32_t> out)
+{
+    return parse_list(text, delimiter, out);
+}
+
+std::size_t parse_integer_list(std::string_view text, char delimiter, std::span<std::int64_t> out)
+{
+    return parse_list(text, delimiter, out);
+}
+
+#ifdef _WIN32
+
+mapped_file::mapped_file(const std::filesystem::path& path)
+{
+    auto fail = [&] {
+        unmap();
+        throw std::runtime_error{fmt::format("Unable to map {}", path.string())};
+    };
+
+    file_ = CreateFileW(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+        nullptr);
+    if (file_ == INVALID_HANDLE_VALUE) {
+        file_ = nullptr;
+        fail();
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file_, &size)) fail();
+    if (size.QuadPart == 0) return;
+
+    mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_ == nullptr) fail();
+
+    data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+    if (data_ == nullptr) fail();
+
+    size_ = static_cast<std::size_t>(size.QuadPart);
+}
+
+void mapped_file::unmap() noexcept
+{
+    if (data_ != nullptr) UnmapViewOfFile(data_);
+    if (mapping_ != nullptr) CloseHandle(mapping_);
+    if (file_ != nullptr) CloseHandle(file_);
+
+    data_    = nullptr;
+    size_    = 0;
+    mapping_ = nullptr;
+    file_    = nullptr;
+}
+
+#else
+
+mapped_file::mapped_file(const std::filesystem::path& path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) { throw std::runtime_error{fmt::format("Unable to open {}", path.string())}; }
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error{fmt::format("Unable to stat {}", path.string())};
+    }
+
+    // mmap rejects zero length mappings, an empty file is simply an empty view
+    if (st.st_size > 0) {
+        void* data = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error{fmt::format("Unable to map {}", path.string())};
+        }
+
+        ::madvise(data, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+
+        data_ = static_cast<const char*>(data);
+        size_ = static_cast<std::size_t>(st.st_size);
+    }
+
+    // the mapping keeps its own reference to the file
+    ::close(fd);
+}
+
+void mapped_file::unmap() noexcept
+{
+    if (data_ != nullptr) ::munmap(const_cast<char*>(data_), size_);
+
+    data_ = nullptr;
+    size_ = 0;
+}
+
+#endif
+
+mapped_file::~mapped_file()
+{
+    unmap();
+}
+
+mapped_file::mapped_file(mapped_file&& other) noexcept
+    : data_{std::exchange(other.data_, nullptr)}
+    , size_{std::exchange(other.size_, 0)}
+#ifdef _WIN32
+    , file_{std::exchange(other.file_, nullptr)}
+    , mapping_{std::exchange(other.mapping_, nullptr)}
+#endif
+{
+}
+
+mapped_file& mapped_file::operator=(mapped_file&& other) noexcept
+{
+    if (this != &other) {
+        unmap();
+
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+#ifdef _WIN32
+        file_    = std::exchange(other.file_, nullptr);
+        mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+    }
+
+    return *this;
+}
+
+} // namespace aoc
@@ -0,0 +1,178 @@
+#include <aoc/allocations.hpp>
+#include <aoc/aoc.hpp>
+#include <aoc/input.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+TEST_CASE("Can split text into lines without terminators")
+{
+    std::vector<std::string_view> output;
+    for (auto line : aoc::lines("abc\r\n\ndef\nghi\n")) {
+        output.push_back(line);
+    }
+
+    REQUIRE(4 == output.size());
+
+    REQUIRE("abc" == output[0]);
+    REQUIRE(output[1].empty());
+    REQUIRE("def" == output[2]);
+    REQUIRE("ghi" == output[3]);
+
+    REQUIRE(aoc::lines("").begin() == aoc::lines("").end());
+}
+
+TEST_CASE("Can split a line into fields")
+{
+    std::vector<std::string_view> output;
+    for (auto field : aoc::fields("1-3 a: abcde", ' ')) {
+        output.push_back(field);
+    }
+
+    REQUIRE(3 == output.size());
+
+    REQUIRE("1-3" == output[0]);
+    REQUIRE("a:" == output[1]);
+    REQUIRE("abcde" == output[2]);
+}
+
+TEST_CASE("Can parse a whole field as a number")
+{
+    REQUIRE(1721 == aoc::parse_number<int>("1721"));
+    REQUIRE(-42 == aoc::parse_number<int>(" -42\r"));
+    REQUIRE(7 == aoc::parse_number<int>("+7"));
+
+    REQUIRE_THROWS_AS(aoc::parse_number<int>("12x"), std::invalid_argument);
+    REQUIRE_THROWS_AS(aoc::parse_number<int>(""), std::invalid_argument);
+}
+
+TEST_CASE("Can read a newline delimited list of ints from a view")
+{
+    auto output = aoc::read_element_per_line<int>("1721\n979\n366\n\n299\n675\n1456\n");
+
+    REQUIRE(6 == output.size());
+
+    REQUIRE(1721 == output[0]);
+    REQUIRE(366 == output[2]);
+    REQUIRE(1456 == output[5]);
+}
+
+TEST_CASE("Can read a character delimited list of ints from a view")
+{
+    auto output = aoc::split_line_by<int>(std::string_view{"3,4,3,1,2\n"}, ',');
+
+    REQUIRE(5 == output.size());
+
+    REQUIRE(3 == output[0]);
+    REQUIRE(4 == output[1]);
+    REQUIRE(2 == output[4]);
+}
+
+TEST_CASE("Can map a file into memory")
+{
+    auto path = std::filesystem::temp_directory_path() / "aoc_input_tests.in";
+
+    {
+        std::ofstream ofs{path, std::ios::binary};
+        ofs << "199\n200\n208\n";
+    }
+
+    {
+        aoc::mapped_file file{path};
+        REQUIRE("199\n200\n208\n" == file.contents());
+
+        aoc::mapped_file moved{std::move(file)};
+        REQUIRE(3 == aoc::read_element_per_line<int>(moved.contents()).size());
+    }
+
+    std::filesystem::remove(path);
+
+    REQUIRE_THROWS_AS(aoc::mapped_file{path}, std::runtime_error);
+}
+
+TEST_CASE("Can parse a delimited list of ints into a buffer")
+{
+    std::vector<std::int64_t> output(8);
+
+    auto count = aoc::parse_integer_list("3,-4,+3,1234567890123,2, 7", ',', output);
+
+    REQUIRE(6 == count);
+
+    REQUIRE(3 == output[0]);
+    REQUIRE(-4 == output[1]);
+    REQUIRE(3 == output[2]);
+    REQUIRE(1234567890123 == output[3]);
+    REQUIRE(2 == output[4]);
+    REQUIRE(7 == output[5]);
+
+    REQUIRE(3 == aoc::parse_integer_list("199\r\n\n200\n208\n", '\n', output));
+    REQUIRE(208 == output[2]);
+
+    REQUIRE_THROWS_AS(aoc::parse_integer_list("1,2,", ',', output), std::invalid_argument);
+    REQUIRE_THROWS_AS(aoc::parse_integer_list("1,2,3", ',', std::span{output}.first(2)), std::length_error);
+}
+
+TEST_CASE("Parsing into a preallocated buffer does not allocate")
+{
+    std::vector<std::int32_t> output(1024);
+
+    std::string text;
+    for (int i = 0; i < 1000; ++i) {
+        text += std::to_string(i) + '\n';
+    }
+
+    aoc::allocations::scope scope;
+
+    auto count  = aoc::parse_integer_list(text, '\n', output);
+    auto fields = aoc::count_fields("12,14,1969,100756", ',');
+    auto used   = scope.used();
+
+    REQUIRE(0 == used.count);
+
+    REQUIRE(1000 == count);
+    REQUIRE(4 == fields);
+}
+
+TEST_CASE("Can parse a delimited list longer than one SIMD block")
+{
+    std::string      text;
+    std::vector<int> expected;
+
+    for (int i = 0; i < 1000; ++i) {
+        expected.push_back(i * 7919 - 500000);
+        text += (i == 0 ? "" : ",") + std::to_string(expected.back());
+    }
+
+    REQUIRE(1000 == aoc::count_fields(text, ','));
+    REQUIRE(expected == aoc::split_line_by<int>(std::string_view{text}));
+}
+
+TEST_CASE("Can count a character in text of any length")
+{
+    std::string text;
+    for (int i = 0; i < 100; ++i) {
+        text += i % 3 == 0 ? 'a' : 'b';
+    }
+
+    std::string_view view{text};
+
+    for (std::size_t length = 0; length <= view.size(); ++length) {
+        auto expected = static_cast<std::size_t>(std::ranges::count(view.substr(0, length), 'a'));
+
+        REQUIRE(expected == aoc::count_char(view.substr(0, length), 'a'));
+        REQUIRE(expected == aoc::count_char(view.substr(0, length), 'a', view));
+    }
+
+    // Reads past the end of the text stay inside the buffer and are not counted.
+    REQUIRE(1 == aoc::count_char(view.substr(96, 3), 'a', view));
+    REQUIRE(2 == aoc::count_char(view.substr(3, 4), 'a', view));
+}
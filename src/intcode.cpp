@@ -1,33 +1,623 @@
 
 #include "intcode.hpp"
+#include "aoc.hpp"
+#include "intcode_analysis.hpp"
+#include "trace.hpp"
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define AOC_INTCODE_COMPUTED_GOTO 1
+#else
+#define AOC_INTCODE_COMPUTED_GOTO 0
+#endif
+
 namespace aoc {
 
 std::vector<int> compute(std::vector<int> program)
 {
-    int instruction_pointer = 0;
+    AOC_TRACE_SCOPE("intcode/compute");
+
+    intcode::vm machine{std::vector<intcode::word>(program.begin(), program.end())};
+
+    if (machine.run() != intcode::status::halted) {
+        throw std::runtime_error{"Intcode program is waiting for input"};
+    }
+
+    for (std::size_t i = 0; i < program.size(); ++i) {
+        program[i] = static_cast<int>(machine.read(i));
+    }
+
+    return program;
+}
+
+namespace intcode {
+
+    namespace {
+
+        constexpr int modes_divisor(std::size_t offset)
+        {
+            constexpr int divisors[] = {1, 100, 1000, 10000};
+            return divisors[offset];
+        }
+
+        // Handlers of the threaded engine, in the order of its jump table.
+        enum op : std::uint8_t {
+            op_decode,
+            op_add,
+            op_multiply,
+            op_input,
+            op_output,
+            op_jump_if_true,
+            op_jump_if_false,
+            op_less_than,
+            op_equals,
+            op_adjust_base,
+            op_halt,
+        };
+
+        constexpr std::size_t op_length[] = {0, 4, 4, 2, 2, 3, 3, 4, 4, 2, 1};
+
+        std::size_t checked_address(word address)
+        {
+            if (address < 0) {
+                throw std::out_of_range{fmt::format("Negative Intcode address: {}", address)};
+            }
+
+            return static_cast<std::size_t>(address);
+        }
+
+    } // namespace
+
+    std::vector<word> parse_program(std::string_view text)
+    {
+        return split_line_by<word>(text, ',');
+    }
+
+    paged_memory::paged_memory(std::span<const word> contents)
+        : size_{contents.size()}
+    {
+        if (contents.empty()) return;
+
+        table_ = std::make_shared<page_table>();
+
+        for (std::size_t first = 0; first < contents.size(); first += page_size) {
+            auto p = std::make_shared<page>();
+            auto n = std::min(page_size, contents.size() - first);
+
+            std::ranges::copy(contents.subspan(first, n), p->begin());
+            table_->push_back(std::move(p));
+        }
+
+        sync_pages();
+    }
+
+    paged_memory::paged_memory(const paged_memory& other)
+        : table_{other.table_}
+        , pages_{other.pages_}
+        , page_count_{other.page_count_}
+        , size_{other.size_}
+    {
+        other.generation_.store(next_generation(), std::memory_order_relaxed);
+    }
+
+    paged_memory::paged_memory(paged_memory&& other) noexcept
+        : table_{std::move(other.table_)}
+        , pages_{std::exchange(other.pages_, nullptr)}
+        , page_count_{std::exchange(other.page_count_, 0)}
+        , size_{std::exchange(other.size_, 0)}
+    {
+        other.generation_.store(next_generation(), std::memory_order_relaxed);
+    }
+
+    paged_memory& paged_memory::operator=(const paged_memory& other)
+    {
+        if (this == &other) return *this;
+
+        table_      = other.table_;
+        pages_      = other.pages_;
+        page_count_ = other.page_count_;
+        size_       = other.size_;
+        generation_.store(next_generation(), std::memory_order_relaxed);
+        other.generation_.store(next_generation(), std::memory_order_relaxed);
+        return *this;
+    }
+
+    paged_memory& paged_memory::operator=(paged_memory&& other) noexcept
+    {
+        table_      = std::move(other.table_);
+        pages_      = std::exchange(other.pages_, nullptr);
+        page_count_ = std::exchange(other.page_count_, 0);
+        size_       = std::exchange(other.size_, 0);
+        generation_.store(next_generation(), std::memory_order_relaxed);
+        other.generation_.store(next_generation(), std::memory_order_relaxed);
+        return *this;
+    }
+
+    std::uint64_t paged_memory::next_generation()
+    {
+        static std::atomic<std::uint64_t> generation = 0;
+        return generation.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    void paged_memory::sync_pages()
+    {
+        pages_      = table_ ? table_->data() : nullptr;
+        page_count_ = table_ ? table_->size() : 0;
+    }
+
+    word& paged_memory::writable(std::size_t address)
+    {
+        auto index = address / page_size;
+
+        if (!table_ || table_.use_count() > 1 || index >= page_count_) {
+            if (!table_) { table_ = std::make_shared<page_table>(); }
+            else if (table_.use_count() > 1) {
+                // The table is copied before it changes, the pages it points at stay shared.
+                table_ = std::make_shared<page_table>(*table_);
+            }
+
+            if (index >= table_->size()) { table_->resize(index + 1); }
 
-    while (program[instruction_pointer] != 99) {
-        switch (program[instruction_pointer]) {
+            sync_pages();
+        }
+
+        auto& p = (*table_)[index];
+        if (!p) {
+            p = std::make_shared<page>();
+            generation_.store(next_generation(), std::memory_order_relaxed);
+        }
+        else if (p.use_count() > 1) {
+            p = std::make_shared<page>(*p);
+            generation_.store(next_generation(), std::memory_order_relaxed);
+        }
+
+        size_ = std::max(size_, address + 1);
+
+        return (*p)[address % page_size];
+    }
+
+    std::size_t paged_memory::unique_pages() const
+    {
+        if (!table_ || table_.use_count() > 1) return 0;
+
+        return static_cast<std::size_t>(
+            std::ranges::count_if(*table_, [](const auto& p) { return p && p.use_count() == 1; }));
+    }
+
+    vm::vm(std::span<const word> program, intcode::engine engine)
+        : memory_{program}
+        , engine_{engine}
+    {
+    }
+
+    vm::vm(const paged_memory& image, intcode::engine engine)
+        : memory_{image}
+        , engine_{engine}
+    {
+    }
+
+    vm::vm(const vm& other)
+        : memory_{other.memory_}
+        , ip_{other.ip_}
+        , relative_base_{other.relative_base_}
+        , state_{other.state_}
+        , engine_{other.engine_}
+        , executed_{other.executed_}
+        , profile_{other.profile_}
+        , inputs_{other.inputs_}
+        , outputs_{other.outputs_}
+    {
+    }
+
+    vm& vm::operator=(const vm& other)
+    {
+        if (this == &other) return *this;
+
+        memory_        = other.memory_;
+        ip_            = other.ip_;
+        relative_base_ = other.relative_base_;
+        state_         = other.state_;
+        engine_        = other.engine_;
+        executed_      = other.executed_;
+        profile_       = other.profile_;
+        inputs_        = other.inputs_;
+        outputs_       = other.outputs_;
+
+        // Cached code describes the memory just replaced.
+        decoded_.clear();
+        code_cells_.clear();
+        jit_.reset();
+
+        return *this;
+    }
+
+    status vm::run()
+    {
+        AOC_TRACE_SCOPE("intcode/run");
+
+        if (state_ == status::halted) return state_;
+        if (profile_ != nullptr) return run_profiled();
+
+        switch (engine_) {
+            case intcode::engine::threaded: return run_threaded();
+            case intcode::engine::jit: return run_jit();
+            case intcode::engine::interpreter: break;
+        }
+
+        return run_interpreter();
+    }
+
+    status vm::run_interpreter()
+    {
+        while (step() == status::ready) {}
+
+        return state_;
+    }
+
+    status vm::run_profiled()
+    {
+        while (true) {
+            auto address     = ip_;
+            auto instruction = read(ip_);
+
+            if (step() == status::waiting_for_input) return state_;
+
+            profile_->record(address, instruction);
+
+            auto opcode = instruction % 100;
+            if ((opcode == 5 || opcode == 6) && ip_ != address + 3) { profile_->record_jump(ip_); }
+
+            if (state_ != status::ready) return state_;
+        }
+    }
+
+    status vm::step()
+    {
+        AOC_TRACE_COUNT("intcode/instructions", 1);
+
+        auto instruction = read(ip_);
+        auto mode        = [instruction](std::size_t offset) {
+            return static_cast<int>(instruction / modes_divisor(offset) % 10);
+        };
+
+        switch (instruction % 100) {
             case 1: {
-                program[program[instruction_pointer + 3]] = program[program[instruction_pointer + 1]]
-                                                            + program[program[instruction_pointer + 2]];
-                instruction_pointer += 4;
+                store(mode(3), 3) = load(mode(1), 1) + load(mode(2), 2);
+                ip_ += 4;
             } break;
             case 2: {
-                program[program[instruction_pointer + 3]] = program[program[instruction_pointer + 1]]
-                                                            * program[program[instruction_pointer + 2]];
-                instruction_pointer += 4;
+                store(mode(3), 3) = load(mode(1), 1) * load(mode(2), 2);
+                ip_ += 4;
+            } break;
+            case 3: {
+                if (inputs_.empty()) return state_ = status::waiting_for_input;
+
+                store(mode(1), 1) = inputs_.front();
+                inputs_.pop_front();
+                ip_ += 2;
+            } break;
+            case 4: {
+                outputs_.push_back(load(mode(1), 1));
+                ip_ += 2;
+            } break;
+            case 5: {
+                ip_ = load(mode(1), 1) != 0 ? static_cast<std::size_t>(load(mode(2), 2)) : ip_ + 3;
+            } break;
+            case 6: {
+                ip_ = load(mode(1), 1) == 0 ? static_cast<std::size_t>(load(mode(2), 2)) : ip_ + 3;
+            } break;
+            case 7: {
+                store(mode(3), 3) = load(mode(1), 1) < load(mode(2), 2) ? 1 : 0;
+                ip_ += 4;
             } break;
+            case 8: {
+                store(mode(3), 3) = load(mode(1), 1) == load(mode(2), 2) ? 1 : 0;
+                ip_ += 4;
+            } break;
+            case 9: {
+                relative_base_ += load(mode(1), 1);
+                ip_ += 2;
+            } break;
+            case 99: {
+                ++executed_;
+                return state_ = status::halted;
+            }
             default: {
-                std::runtime_error{fmt::format("Invalid Opcode: {}", program[instruction_pointer])};
+                throw std::runtime_error{fmt::format("Invalid Opcode: {} at {}", instruction, ip_)};
             }
         }
+
+        ++executed_;
+        return state_ = status::ready;
     }
 
-    return program;
-}
+    status vm::run_threaded()
+    {
+        const decoded_instruction* d = nullptr;
+
+#if AOC_INTCODE_COMPUTED_GOTO
+        static void* const targets[] = {
+            &&target_decode,
+            &&target_add,
+            &&target_multiply,
+            &&target_input,
+            &&target_output,
+            &&target_jump_if_true,
+            &&target_jump_if_false,
+            &&target_less_than,
+            &&target_equals,
+            &&target_adjust_base,
+            &&target_halt,
+        };
+
+#define AOC_INTCODE_TARGET(name) target_##name:
+#define AOC_INTCODE_DISPATCH()                                                                          \
+    d = &fetch();                                                                                       \
+    goto* targets[d->op]
+
+        AOC_INTCODE_DISPATCH();
+#else
+#define AOC_INTCODE_TARGET(name) case op_##name:
+#define AOC_INTCODE_DISPATCH() continue
+
+        for (;;) {
+            d = &fetch();
+
+            switch (d->op) {
+#endif
+
+        AOC_INTCODE_TARGET(decode)
+        {
+            decode();
+            AOC_INTCODE_DISPATCH();
+        }
+
+        AOC_INTCODE_TARGET(add)
+        {
+            write_operand(*d, 2, operand(*d, 0) + operand(*d, 1));
+            ip_ += 4;
+            ++executed_;
+            AOC_INTCODE_DISPATCH();
+        }
+
+        AOC_INTCODE_TARGET(multiply)
+        {
+            write_operand(*d, 2, operand(*d, 0) * operand(*d, 1));
+            ip_ += 4;
+            ++executed_;
+            AOC_INTCODE_DISPATCH();
+        }
+
+        AOC_INTCODE_TARGET(input)
+        {
+            if (inputs_.empty()) return state_ = status::waiting_for_input;
+
+            write_operand(*d, 0, inputs_.front());
+            inputs_.pop_front();
+            ip_ += 2;
+            ++executed_;
+            AOC_INTCODE_DISPATCH();
+        }
+
+        AOC_INTCODE_TARGET(output)
+        {
+            outputs_.push_back(operand(*d, 0));
+            ip_ += 2;
+            ++executed_;
+            AOC_INTCODE_DISPATCH();
+        }
+
+        AOC_INTCODE_TARGET(jump_if_true)
+        {
+            ip_ = operand(*d, 0) != 0 ? static_cast<std::size_t>(operand(*d, 1)) : ip_ + 3;
+            ++executed_;
+            AOC_INTCODE_DISPATCH();
+        }
+
+        AOC_INTCODE_TARGET(jump_if_false)
+        {
+            ip_ = operand(*d, 0) == 0 ? static_cast<std::size_t>(operand(*d, 1)) : ip_ + 3;
+            ++executed_;
+            AOC_INTCODE_DISPATCH();
+        }
+
+        AOC_INTCODE_TARGET(less_than)
+        {
+            write_operand(*d, 2, operand(*d, 0) < operand(*d, 1) ? 1 : 0);
+            ip_ += 4;
+            ++executed_;
+            AOC_INTCODE_DISPATCH();
+        }
+
+        AOC_INTCODE_TARGET(equals)
+        {
+            write_operand(*d, 2, operand(*d, 0) == operand(*d, 1) ? 1 : 0);
+            ip_ += 4;
+            ++executed_;
+            AOC_INTCODE_DISPATCH();
+        }
+
+        AOC_INTCODE_TARGET(adjust_base)
+        {
+            relative_base_ += operand(*d, 0);
+            ip_ += 2;
+            ++executed_;
+            AOC_INTCODE_DISPATCH();
+        }
+
+        AOC_INTCODE_TARGET(halt)
+        {
+            ++executed_;
+            return state_ = status::halted;
+        }
+
+#if !AOC_INTCODE_COMPUTED_GOTO
+            }
+        }
+#endif
+
+#undef AOC_INTCODE_TARGET
+#undef AOC_INTCODE_DISPATCH
+    }
+
+    const vm::decoded_instruction& vm::fetch() const
+    {
+        static constexpr decoded_instruction undecoded{};
+
+        return ip_ < decoded_.size() ? decoded_[ip_] : undecoded;
+    }
+
+    void vm::decode()
+    {
+        auto instruction = read(ip_);
+
+        decoded_instruction d;
+
+        switch (instruction % 100) {
+            case 1: d.op = op_add; break;
+            case 2: d.op = op_multiply; break;
+            case 3: d.op = op_input; break;
+            case 4: d.op = op_output; break;
+            case 5: d.op = op_jump_if_true; break;
+            case 6: d.op = op_jump_if_false; break;
+            case 7: d.op = op_less_than; break;
+            case 8: d.op = op_equals; break;
+            case 9: d.op = op_adjust_base; break;
+            case 99: d.op = op_halt; break;
+            default: throw std::runtime_error{fmt::format("Invalid Opcode: {} at {}", instruction, ip_)};
+        }
+
+        auto length = op_length[d.op];
+
+        for (std::size_t i = 0; i + 1 < length; ++i) {
+            switch (instruction / modes_divisor(i + 1) % 10) {
+                case 0: d.kinds[i] = operand_kind::position; break;
+                case 1: d.kinds[i] = operand_kind::immediate; break;
+                case 2: d.kinds[i] = operand_kind::relative; break;
+                default: d.kinds[i] = operand_kind::invalid; break;
+            }
+
+            d.operands[i] = read(ip_ + i + 1);
+        }
+
+        // Grown with the code actually reached rather than the whole memory, so a fresh copy of a machine
+        // with a large memory does not pay for it on its first step.
+        if (decoded_.size() < ip_ + length) {
+            auto size = std::max({ip_ + length, decoded_.size() * 2, std::size_t{64}});
+            decoded_.resize(size);
+            code_cells_.resize(std::max(size, code_cells_.size()));
+        }
+
+        decoded_[ip_] = d;
+        std::fill_n(code_cells_.begin() + static_cast<std::ptrdiff_t>(ip_), length, std::uint8_t{1});
+    }
+
+    std::size_t vm::operand_address(const decoded_instruction& d, std::size_t i) const
+    {
+        switch (d.kinds[i]) {
+            case operand_kind::position: return checked_address(d.operands[i]);
+            case operand_kind::relative: return checked_address(relative_base_ + d.operands[i]);
+            case operand_kind::immediate: break;
+            case operand_kind::invalid: {
+                auto mode = read(ip_) / modes_divisor(i + 1) % 10;
+                throw std::runtime_error{fmt::format("Invalid parameter mode: {} at {}", mode, ip_)};
+            }
+        }
+
+        throw std::runtime_error{fmt::format("Write in immediate mode at {}", ip_)};
+    }
+
+    word vm::operand(const decoded_instruction& d, std::size_t i) const
+    {
+        if (d.kinds[i] == operand_kind::immediate) return d.operands[i];
+
+        return read(operand_address(d, i));
+    }
+
+    void vm::write_operand(const decoded_instruction& d, std::size_t i, word value)
+    {
+        auto address = operand_address(d, i);
+
+        invalidate_code(address);
+        memory_.writable(address) = value;
+    }
+
+    word vm::pop_output()
+    {
+        if (outputs_.empty()) throw std::runtime_error{"Intcode machine has no pending output"};
+
+        auto value = outputs_.front();
+        outputs_.pop_front();
+        return value;
+    }
+
+    std::vector<word> vm::take_outputs()
+    {
+        std::vector<word> result(outputs_.begin(), outputs_.end());
+        outputs_.clear();
+        return result;
+    }
+
+    word& vm::operator[](std::size_t address)
+    {
+        // The caller may write through the reference, so every cached instruction is suspect.
+        if (!code_cells_.empty()) {
+            decoded_.clear();
+            code_cells_.clear();
+            jit_.reset();
+        }
+
+        return memory_.writable(address);
+    }
+
+    void vm::invalidate_code(std::size_t address)
+    {
+        if (address >= code_cells_.size() || code_cells_[address] == 0) return;
+
+        // Any instruction starting up to three cells earlier may have been decoded from this cell.
+        for (std::size_t back = 0; back < 4 && back <= address; ++back) {
+            if (address - back >= decoded_.size()) continue;
+
+            auto& d = decoded_[address - back];
+            if (op_length[d.op] > back) { d = decoded_instruction{}; }
+        }
+
+        jit_.invalidate(address);
+    }
+
+    std::size_t vm::parameter_address(int mode, std::size_t offset)
+    {
+        switch (mode) {
+            case 0: return checked_address(read(ip_ + offset));
+            case 1: return ip_ + offset;
+            case 2: return checked_address(relative_base_ + read(ip_ + offset));
+            default: {
+                throw std::runtime_error{fmt::format("Invalid parameter mode: {} at {}", mode, ip_)};
+            }
+        }
+    }
+
+    word vm::load(int mode, std::size_t offset)
+    {
+        return read(parameter_address(mode, offset));
+    }
+
+    word& vm::store(int mode, std::size_t offset)
+    {
+        if (mode == 1) throw std::runtime_error{fmt::format("Write in immediate mode at {}", ip_)};
+
+        auto address = parameter_address(mode, offset);
+
+        invalidate_code(address);
+        return memory_.writable(address);
+    }
+
+} // namespace intcode
 
-}
\ No newline at end of file
+} // namespace aoc
@@ -0,0 +1,488 @@
+#include "intcode_analysis.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+namespace aoc::intcode {
+
+namespace {
+
+    struct opcode_info {
+        int         opcode;
+        const char* mnemonic;
+        std::size_t operands;
+    };
+
+    constexpr opcode_info opcodes[] = {
+        {1, "add", 3},
+        {2, "mul", 3},
+        {3, "in", 1},
+        {4, "out", 1},
+        {5, "jnz", 2},
+        {6, "jz", 2},
+        {7, "lt", 3},
+        {8, "eq", 3},
+        {9, "arb", 1},
+        {99, "hlt", 0},
+    };
+
+    const opcode_info* find_opcode(word instruction)
+    {
+        auto it = std::ranges::find(opcodes, instruction % 100, &opcode_info::opcode);
+        return it != std::end(opcodes) ? &*it : nullptr;
+    }
+
+    std::string format_operand(int mode, word value)
+    {
+        switch (mode) {
+            case 0: return fmt::format("[{}]", value);
+            case 1: return fmt::format("{}", value);
+            default: return value < 0 ? fmt::format("[rb{}]", value) : fmt::format("[rb+{}]", value);
+        }
+    }
+
+    std::vector<std::pair<std::size_t, std::uint64_t>>
+    busiest(const std::vector<std::uint64_t>& counts, std::size_t count)
+    {
+        std::vector<std::pair<std::size_t, std::uint64_t>> hot;
+
+        for (std::size_t i = 0; i < counts.size(); ++i) {
+            if (counts[i] != 0) hot.emplace_back(i, counts[i]);
+        }
+
+        auto busier = [](const auto& a, const auto& b) {
+            return a.second != b.second ? a.second > b.second : a.first < b.first;
+        };
+
+        count = std::min(count, hot.size());
+        std::ranges::partial_sort(hot, hot.begin() + static_cast<std::ptrdiff_t>(count), busier);
+        hot.resize(count);
+
+        return hot;
+    }
+
+    double percent(std::uint64_t part, std::uint64_t whole)
+    {
+        return whole == 0 ? 0.0 : 100.0 * static_cast<double>(part) / static_cast<double>(whole);
+    }
+
+    word checked_add(word a, word b)
+    {
+        constexpr auto max = std::numeric_limits<word>::max();
+        constexpr auto min = std::numeric_limits<word>::min();
+
+        if ((b > 0 && a > max - b) || (b < 0 && a < min - b)) {
+            throw std::overflow_error{"Intcode polynomial coefficient overflow"};
+        }
+
+        return a + b;
+    }
+
+    word checked_multiply(word a, word b)
+    {
+        constexpr auto max = std::numeric_limits<word>::max();
+        constexpr auto min = std::numeric_limits<word>::min();
+
+        if (a == 0 || b == 0) return 0;
+
+        auto overflows = a > 0 ? (b > 0 ? a > max / b : b < min / a)
+                               : (b > 0 ? a < min / b : b < max / a);
+        if (overflows) throw std::overflow_error{"Intcode polynomial coefficient overflow"};
+
+        return a * b;
+    }
+
+    word checked_power(word base, unsigned exponent)
+    {
+        word result = 1;
+        for (unsigned i = 0; i < exponent; ++i) {
+            result = checked_multiply(result, base);
+        }
+
+        return result;
+    }
+
+    // Thrown inside run_symbolic when the program leaves the analyzable subset.
+    struct not_analyzable {};
+
+} // namespace
+
+disassembled_instruction disassemble_at(const paged_memory& memory, std::size_t address)
+{
+    auto instruction = memory.read(address);
+    auto data        = disassembled_instruction{address, 1, fmt::format("data {}", instruction)};
+
+    const auto* info = instruction > 0 ? find_opcode(instruction) : nullptr;
+    if (info == nullptr || instruction / 100 >= 1000) return data;
+
+    std::string text = info->mnemonic;
+
+    for (std::size_t i = 0; i < info->operands; ++i) {
+        constexpr word divisors[] = {100, 1000, 10000};
+
+        auto mode = static_cast<int>(instruction / divisors[i] % 10);
+        if (mode > 2) return data;
+
+        text += i == 0 ? " " : ", ";
+        text += format_operand(mode, memory.read(address + i + 1));
+    }
+
+    return {address, info->operands + 1, std::move(text)};
+}
+
+std::vector<disassembled_instruction>
+disassemble(const paged_memory& memory, std::size_t first, std::size_t last)
+{
+    last = std::min(last, memory.size());
+
+    std::vector<disassembled_instruction> instructions;
+
+    for (auto address = first; address < last;) {
+        instructions.push_back(disassemble_at(memory, address));
+        address += instructions.back().length;
+    }
+
+    return instructions;
+}
+
+std::string listing(const paged_memory& memory, std::size_t first, std::size_t last)
+{
+    std::string text;
+
+    for (const auto& instruction : disassemble(memory, first, last)) {
+        std::string cells;
+        for (std::size_t i = 0; i < instruction.length; ++i) {
+            cells += fmt::format("{}{}", i == 0 ? "" : ",", memory.read(instruction.address + i));
+        }
+
+        text += fmt::format("{:>6}  {:<28} {}\n", instruction.address, cells, instruction.text);
+    }
+
+    return text;
+}
+
+std::vector<std::pair<std::size_t, std::uint64_t>> profile::hot_addresses(std::size_t count) const
+{
+    return busiest(by_address_, count);
+}
+
+std::vector<std::pair<std::size_t, std::uint64_t>> profile::hot_jump_targets(std::size_t count) const
+{
+    return busiest(jumps_to_, count);
+}
+
+std::string profile::flat(const paged_memory& memory, std::size_t rows) const
+{
+    auto text = fmt::format("{} instructions executed\n\n", total_);
+
+    text += fmt::format(
+        "{:>7}  {:>7}  {:>14}  {:>7}  {}\n", "%", "cum %", "executions", "address", "instruction");
+
+    std::uint64_t cumulative = 0;
+
+    for (auto [address, count] : hot_addresses(rows)) {
+        cumulative += count;
+        text += fmt::format(
+            "{:>6.2f}%  {:>6.2f}%  {:>14}  {:>7}  {}\n",
+            percent(count, total_),
+            percent(cumulative, total_),
+            count,
+            address,
+            disassemble_at(memory, address).text);
+    }
+
+    text += fmt::format("\n{:>7}  {:>14}  {}\n", "%", "executions", "opcode");
+
+    std::vector<std::pair<std::size_t, std::uint64_t>> mix;
+    for (std::size_t opcode = 0; opcode < by_opcode_.size(); ++opcode) {
+        if (by_opcode_[opcode] != 0) mix.emplace_back(opcode, by_opcode_[opcode]);
+    }
+
+    std::ranges::stable_sort(mix, [](const auto& a, const auto& b) { return a.second > b.second; });
+
+    for (auto [opcode, count] : mix) {
+        const auto* info = find_opcode(static_cast<word>(opcode));
+        text += fmt::format(
+            "{:>6.2f}%  {:>14}  {}\n",
+            percent(count, total_),
+            count,
+            info != nullptr ? info->mnemonic : fmt::format("?{}", opcode));
+    }
+
+    auto targets = hot_jump_targets(rows);
+
+    if (!targets.empty()) {
+        text += fmt::format("\n{:>14}  {:>7}  {}\n", "jumps taken", "target", "instruction");
+
+        for (auto [target, count] : targets) {
+            auto instruction = disassemble_at(memory, target);
+            text += fmt::format("{:>14}  {:>7}  {}\n", count, target, instruction.text);
+        }
+    }
+
+    return text;
+}
+
+polynomial::polynomial(word constant)
+{
+    if (constant != 0) terms_[{}] = constant;
+}
+
+polynomial polynomial::variable(std::size_t index)
+{
+    exponents e(index + 1, 0);
+    e[index] = 1;
+
+    polynomial p;
+    p.terms_[e] = 1;
+    return p;
+}
+
+bool polynomial::is_constant() const
+{
+    return terms_.empty() || (terms_.size() == 1 && terms_.begin()->first.empty());
+}
+
+word polynomial::constant_term() const
+{
+    auto it = terms_.find({});
+    return it != terms_.end() ? it->second : 0;
+}
+
+unsigned polynomial::degree(std::size_t variable) const
+{
+    unsigned highest = 0;
+
+    for (const auto& [e, coefficient] : terms_) {
+        if (variable < e.size()) highest = std::max(highest, e[variable]);
+    }
+
+    return highest;
+}
+
+word polynomial::evaluate(std::span<const word> values) const
+{
+    word sum = 0;
+
+    for (const auto& [e, coefficient] : terms_) {
+        auto term = coefficient;
+
+        for (std::size_t i = 0; i < e.size(); ++i) {
+            if (e[i] == 0) continue;
+            if (i >= values.size()) throw std::out_of_range{fmt::format("No value for x{}", i)};
+
+            term = checked_multiply(term, checked_power(values[i], e[i]));
+        }
+
+        sum = checked_add(sum, term);
+    }
+
+    return sum;
+}
+
+polynomial polynomial::substitute(std::size_t variable, word value) const
+{
+    polynomial result;
+
+    for (const auto& [term, c] : terms_) {
+        auto e           = term;
+        auto coefficient = c;
+
+        if (variable < e.size() && e[variable] != 0) {
+            coefficient = checked_multiply(coefficient, checked_power(value, e[variable]));
+            e[variable] = 0;
+
+            while (!e.empty() && e.back() == 0) {
+                e.pop_back();
+            }
+        }
+
+        auto& sum = result.terms_[e];
+        sum       = checked_add(sum, coefficient);
+        if (sum == 0) result.terms_.erase(e);
+    }
+
+    return result;
+}
+
+std::string polynomial::to_string() const
+{
+    if (terms_.empty()) return "0";
+
+    auto total_degree = [](const exponents& e) {
+        unsigned total = 0;
+        for (auto power : e) {
+            total += power;
+        }
+        return total;
+    };
+
+    // Lower degrees first, within a degree the lower numbered variables first.
+    std::vector<std::pair<exponents, word>> ordered(terms_.begin(), terms_.end());
+    std::ranges::stable_sort(ordered, [&total_degree](const auto& a, const auto& b) {
+        auto da = total_degree(a.first), db = total_degree(b.first);
+        return da != db ? da < db : a.first > b.first;
+    });
+
+    std::string text;
+
+    for (const auto& [e, coefficient] : ordered) {
+        auto magnitude = coefficient < 0 ? -coefficient : coefficient;
+
+        if (text.empty()) { text += coefficient < 0 ? "-" : ""; }
+        else {
+            text += coefficient < 0 ? " - " : " + ";
+        }
+
+        std::string factors;
+        for (std::size_t i = 0; i < e.size(); ++i) {
+            if (e[i] == 0) continue;
+
+            factors += factors.empty() ? "" : "*";
+            factors += e[i] == 1 ? fmt::format("x{}", i) : fmt::format("x{}^{}", i, e[i]);
+        }
+
+        if (factors.empty()) { text += fmt::format("{}", magnitude); }
+        else if (magnitude == 1) {
+            text += factors;
+        }
+        else {
+            text += fmt::format("{}*{}", magnitude, factors);
+        }
+    }
+
+    return text;
+}
+
+polynomial operator+(const polynomial& a, const polynomial& b)
+{
+    auto result = a;
+
+    for (const auto& [e, coefficient] : b.terms_) {
+        auto& sum = result.terms_[e];
+        sum       = checked_add(sum, coefficient);
+        if (sum == 0) result.terms_.erase(e);
+    }
+
+    return result;
+}
+
+polynomial operator*(const polynomial& a, const polynomial& b)
+{
+    polynomial result;
+
+    for (const auto& [ea, ca] : a.terms_) {
+        for (const auto& [eb, cb] : b.terms_) {
+            polynomial::exponents e(std::max(ea.size(), eb.size()), 0);
+            for (std::size_t i = 0; i < e.size(); ++i) {
+                e[i] = (i < ea.size() ? ea[i] : 0) + (i < eb.size() ? eb[i] : 0);
+            }
+
+            auto& sum = result.terms_[e];
+            sum       = checked_add(sum, checked_multiply(ca, cb));
+            if (sum == 0) result.terms_.erase(e);
+        }
+    }
+
+    return result;
+}
+
+std::optional<symbolic_memory>
+run_symbolic(std::span<const word> program, std::span<const std::size_t> unknown_cells)
+{
+    // Straight line code only moves forward, these only stop programs that keep writing ahead of
+    // themselves.
+    constexpr std::size_t max_steps   = 1'000'000;
+    constexpr word        max_address = word{1} << 24;
+
+    symbolic_memory memory;
+    memory.reserve(program.size());
+
+    for (auto value : program) {
+        memory.emplace_back(polynomial{value});
+    }
+
+    for (std::size_t i = 0; i < unknown_cells.size(); ++i) {
+        if (unknown_cells[i] >= memory.size()) { memory.resize(unknown_cells[i] + 1, polynomial{}); }
+        memory[unknown_cells[i]] = polynomial::variable(i);
+    }
+
+    auto cell = [&memory](std::size_t address) -> std::optional<polynomial> {
+        return address < memory.size() ? memory[address] : polynomial{};
+    };
+
+    auto known_address = [](const std::optional<polynomial>& value) -> std::optional<std::size_t> {
+        if (!value || !value->is_constant()) return std::nullopt;
+
+        auto address = value->constant_term();
+        if (address < 0 || address >= max_address) throw not_analyzable{};
+
+        return static_cast<std::size_t>(address);
+    };
+
+    try {
+        std::size_t ip = 0;
+
+        for (std::size_t step = 0; step < max_steps; ++step, ip += 4) {
+            auto instruction = cell(ip);
+            if (!instruction || !instruction->is_constant()) return std::nullopt;
+
+            auto opcode = instruction->constant_term();
+            if (opcode % 100 == 99) return memory;
+            if (opcode % 100 != 1 && opcode % 100 != 2) return std::nullopt;
+
+            auto operand = [&](std::size_t i) -> std::optional<polynomial> {
+                constexpr word divisors[] = {100, 1000, 10000};
+
+                switch (opcode / divisors[i - 1] % 10) {
+                    case 0: {
+                        auto parameter = cell(ip + i);
+                        if (parameter && !parameter->is_constant()) return std::nullopt;
+
+                        auto address = known_address(parameter);
+                        return address ? cell(*address) : std::nullopt;
+                    }
+                    case 1: return cell(ip + i);
+                    default: throw not_analyzable{};
+                }
+            };
+
+            auto a = operand(1);
+            auto b = operand(2);
+
+            if (opcode / 10000 % 10 != 0) return std::nullopt;
+
+            auto target = known_address(cell(ip + 3));
+            if (!target) return std::nullopt;
+
+            if (*target >= memory.size()) { memory.resize(*target + 1, polynomial{}); }
+
+            if (a && b) { memory[*target] = opcode % 100 == 1 ? *a + *b : *a * *b; }
+            else {
+                memory[*target] = std::nullopt;
+            }
+        }
+    }
+    catch (const not_analyzable&) {
+        return std::nullopt;
+    }
+    catch (const std::overflow_error&) {
+        return std::nullopt;
+    }
+
+    return std::nullopt;
+}
+
+void profile::clear()
+{
+    by_address_.clear();
+    by_opcode_.fill(0);
+    jumps_to_.clear();
+    total_ = 0;
+}
+
+} // namespace aoc::intcode
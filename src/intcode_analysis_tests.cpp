@@ -0,0 +1,141 @@
+#include <aoc/intcode_analysis.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+TEST_CASE("Can disassemble an Intcode program")
+{
+    using aoc::intcode::paged_memory;
+    using aoc::intcode::parse_program;
+
+    paged_memory memory{parse_program("1002,4,3,4,33,109,-7,21101,1,2,3,204,5,1105,1,0,99,42,30002")};
+
+    auto instructions = aoc::intcode::disassemble(memory);
+
+    std::vector<std::string> text;
+    for (const auto& instruction : instructions) {
+        text.push_back(instruction.text);
+    }
+
+    REQUIRE(
+        std::vector<std::string>{
+            "mul [4], 3, [4]",
+            "data 33",
+            "arb -7",
+            "add 1, 2, [rb+3]",
+            "out [rb+5]",
+            "jnz 1, 0",
+            "hlt",
+            "data 42",
+            "data 30002"}
+        == text);
+
+    REQUIRE(5 == instructions[2].address);
+    REQUIRE(4 == instructions[3].length);
+
+    auto first_line = aoc::intcode::listing(memory, 0, 1);
+    REQUIRE("     0  1002,4,3,4                   mul [4], 3, [4]\n" == first_line);
+    REQUIRE(2 == aoc::intcode::disassemble(memory, 13, 17).size());
+}
+
+TEST_CASE("Can profile an Intcode program")
+{
+    using aoc::intcode::engine;
+
+    // Counts cell 100 down from 50, summing it into cell 101.
+    auto program = aoc::intcode::parse_program("1,101,100,101,1001,100,-1,100,1005,100,0,4,101,99");
+    program.resize(102);
+    program[100] = 50;
+
+    for (auto e : {engine::interpreter, engine::threaded, engine::jit}) {
+        aoc::intcode::profile counts;
+        aoc::intcode::vm      machine{program, e};
+
+        machine.set_profile(&counts);
+        REQUIRE(aoc::intcode::status::halted == machine.run());
+        REQUIRE(1275 == machine.pop_output());
+
+        REQUIRE(machine.instructions_executed() == counts.total());
+        REQUIRE(152 == counts.total());
+
+        REQUIRE(50 == counts.executions(0));
+        REQUIRE(50 == counts.executions(8));
+        REQUIRE(1 == counts.executions(11));
+        REQUIRE(0 == counts.executions(1));
+
+        REQUIRE(100 == counts.opcode_executions(1));
+        REQUIRE(50 == counts.opcode_executions(5));
+        REQUIRE(1 == counts.opcode_executions(99));
+
+        // The last pass falls through instead of jumping back.
+        REQUIRE(49 == counts.jumps_to(0));
+        auto targets = counts.hot_jump_targets(5);
+        REQUIRE(1 == targets.size());
+        REQUIRE(std::pair<std::size_t, std::uint64_t>{0, 49} == targets.front());
+        REQUIRE(3 == counts.hot_addresses(3).size());
+        REQUIRE(0 == counts.hot_addresses(3).front().first);
+
+        auto flat = counts.flat(machine.memory(), 2);
+        REQUIRE(flat.starts_with("152 instructions executed\n"));
+        REQUIRE(flat.find(" 32.89%   32.89%              50        0  add [101], [100], [101]\n")
+                != std::string::npos);
+        REQUIRE(flat.find("49        0  add [101], [100], [101]\n") != std::string::npos);
+    }
+}
+
+TEST_CASE("Can do arithmetic on Intcode polynomials")
+{
+    using aoc::intcode::polynomial;
+
+    auto x = polynomial::variable(0);
+    auto y = polynomial::variable(1);
+
+    auto p = (x + 3) * (x + y * -2) + 5;
+
+    REQUIRE("5 + 3*x0 - 6*x1 + x0^2 - 2*x0*x1" == p.to_string());
+    REQUIRE(2 == p.degree(0));
+    REQUIRE(1 == p.degree(1));
+    REQUIRE(0 == p.degree(2));
+    REQUIRE(5 == p.constant_term());
+    REQUIRE_FALSE(p.is_constant());
+
+    REQUIRE(5 + 3 * 4 - 6 * 7 + 16 - 2 * 4 * 7 == p.evaluate(std::vector<aoc::intcode::word>{4, 7}));
+    REQUIRE("15 - 10*x1" == p.substitute(0, 2).to_string());
+    REQUIRE((x + 1) * (x + -1) == x * x + -1);
+    REQUIRE((x + x * -1 + 7).is_constant());
+
+    REQUIRE_THROWS_AS(polynomial{1LL << 62} * 4, std::overflow_error);
+}
+
+TEST_CASE("Can run an Intcode program symbolically")
+{
+    using aoc::intcode::parse_program;
+    using aoc::intcode::run_symbolic;
+
+    constexpr std::size_t unknowns[] = {1, 2};
+
+    // The puzzle example, with its noun and verb made unknown. Reading through them leaves cell 3, and
+    // cell 0 computed from it, unknown.
+    auto memory = run_symbolic(parse_program("1,9,10,3,2,3,11,0,99,30,40,50"), unknowns);
+
+    REQUIRE(memory);
+    REQUIRE(12 == memory->size());
+    REQUIRE_FALSE(memory->front());
+    REQUIRE_FALSE((*memory)[3]);
+
+    auto squares = run_symbolic(parse_program("1,0,0,0,2,1,1,13,1,13,2,0,99"), unknowns);
+
+    REQUIRE(squares);
+    REQUIRE("x1 + x0^2" == squares->front()->to_string());
+    REQUIRE(14 == squares->size());
+
+    // Jumps, unknown opcodes or write addresses and the relative base are all out of reach.
+    REQUIRE_FALSE(run_symbolic(parse_program("1105,1,4,99,99"), unknowns));
+    REQUIRE_FALSE(run_symbolic(parse_program("1101,0,0,4,0,99"), unknowns));
+    REQUIRE_FALSE(run_symbolic(parse_program("1101,0,0,7,1,0,0,0,99"), unknowns));
+    REQUIRE_FALSE(run_symbolic(parse_program("201,0,0,0,99"), unknowns));
+}
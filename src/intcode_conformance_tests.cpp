@@ -0,0 +1,252 @@
+#include <aoc/intcode.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Every engine must leave a machine in exactly the state the interpreter leaves it in.
+
+namespace {
+
+using aoc::intcode::engine;
+using aoc::intcode::word;
+
+struct outcome {
+    aoc::intcode::status status = aoc::intcode::status::ready;
+    std::string          error;
+    std::vector<word>    outputs;
+    std::vector<word>    memory;
+    std::size_t          instruction_pointer = 0;
+    word                 relative_base       = 0;
+    std::uint64_t        instructions        = 0;
+
+    friend bool operator==(const outcome&, const outcome&) = default;
+};
+
+outcome run_on(engine e, const std::vector<word>& program, const std::vector<word>& inputs)
+{
+    aoc::intcode::vm machine{program, e};
+    for (auto input : inputs) {
+        machine.push_input(input);
+    }
+
+    outcome result;
+
+    try {
+        result.status = machine.run();
+    }
+    catch (const std::exception& ex) {
+        result.error = ex.what();
+    }
+
+    result.outputs = machine.take_outputs();
+    for (std::size_t i = 0; i < machine.memory().size(); ++i) {
+        result.memory.push_back(machine.read(i));
+    }
+
+    result.instruction_pointer = machine.instruction_pointer();
+    result.relative_base       = machine.relative_base();
+    result.instructions        = machine.instructions_executed();
+
+    return result;
+}
+
+void require_engines_agree(const std::vector<word>& program, const std::vector<word>& inputs = {})
+{
+    auto expected = run_on(engine::interpreter, program, inputs);
+
+    for (auto e : {engine::threaded, engine::jit}) {
+        INFO(fmt::format("engine {}, program {}", static_cast<int>(e), fmt::join(program, ",")));
+        REQUIRE(expected == run_on(e, program, inputs));
+    }
+}
+
+// Random programs whose jumps only go forward, so they always terminate. Writes go to a data region
+// and, when self_modifying, into the immediate first operand of an add or compare still to come.
+std::vector<word> random_program(std::mt19937& rng, bool self_modifying)
+{
+    auto pick = [&rng](int low, int high) {
+        return std::uniform_int_distribution<int>{low, high}(rng);
+    };
+
+    constexpr word data_size = 16;
+
+    auto count = pick(1, 40);
+
+    // Instruction start addresses are only known once every length is, so lay the code out first.
+    std::vector<int>  opcodes;
+    std::vector<word> starts;
+    word              length = 2; // the leading 109 pointing the relative base at the data region
+
+    for (int i = 0; i < count; ++i) {
+        constexpr int choices[] = {1, 1, 2, 7, 8, 1, 5, 6, 3, 4, 9, 1};
+        opcodes.push_back(choices[pick(0, 11)]);
+        starts.push_back(length);
+
+        switch (opcodes.back()) {
+            case 1:
+            case 2:
+            case 7:
+            case 8: length += 4; break;
+            case 5:
+            case 6: length += 3; break;
+            default: length += 2; break;
+        }
+    }
+
+    auto halt       = length;
+    auto data_start = halt + 1;
+
+    std::vector<word> program{109, data_start};
+    std::set<int>     forced_immediate;
+    int               multiplies = 0;
+
+    auto data_operand = [&](int& mode) -> word {
+        mode = pick(0, 2);
+        if (mode == 1) return pick(-9, 9);
+        if (mode == 2) return pick(0, static_cast<int>(data_size) - 1);
+        return data_start + pick(0, static_cast<int>(data_size) - 1);
+    };
+
+    auto target_operand = [&](int i, int& mode) -> word {
+        if (self_modifying && i + 1 < count && pick(0, 3) == 0) {
+            auto later = pick(i + 1, count - 1);
+            auto op    = opcodes[static_cast<std::size_t>(later)];
+
+            if (op == 1 || op == 7 || op == 8) {
+                forced_immediate.insert(later);
+
+                mode = 0;
+                return starts[static_cast<std::size_t>(later)] + 1;
+            }
+        }
+
+        mode = pick(0, 1) == 0 ? 0 : 2;
+        return mode == 2 ? pick(0, static_cast<int>(data_size) - 1)
+                         : data_start + pick(0, static_cast<int>(data_size) - 1);
+    };
+
+    for (int i = 0; i < count; ++i) {
+        auto opcode = opcodes[static_cast<std::size_t>(i)];
+        int  m1 = 0, m2 = 0, m3 = 0;
+
+        switch (opcode) {
+            case 2:
+                // Bounded so long programs cannot overflow a word.
+                if (++multiplies > 6) opcode = 1;
+                [[fallthrough]];
+            case 1:
+            case 7:
+            case 8: {
+                auto a = data_operand(m1);
+                auto b = opcode == 2 ? (m2 = 1, static_cast<word>(pick(-3, 3))) : data_operand(m2);
+                auto c = target_operand(i, m3);
+
+                if (forced_immediate.contains(i)) {
+                    m1 = 1;
+                    a  = pick(-9, 9);
+                }
+
+                program.insert(program.end(), {opcode + 100 * m1 + 1000 * m2 + 10000 * m3, a, b, c});
+            } break;
+            case 5:
+            case 6: {
+                auto condition = data_operand(m1);
+                auto later     = pick(i + 1, count);
+                auto target    = later == count ? halt : starts[static_cast<std::size_t>(later)];
+
+                program.insert(program.end(), {opcode + 100 * m1 + 1000, condition, target});
+            } break;
+            case 3: {
+                auto c = target_operand(i, m1);
+                program.insert(program.end(), {3 + 100 * m1, c});
+            } break;
+            case 4: {
+                auto a = data_operand(m1);
+                program.insert(program.end(), {4 + 100 * m1, a});
+            } break;
+            default: {
+                // Net zero adjustments keep relative operands inside the data region.
+                program.insert(program.end(), {109, 0});
+            } break;
+        }
+    }
+
+    program.push_back(99);
+
+    for (word i = 0; i < data_size; ++i) {
+        program.push_back(pick(-100, 100));
+    }
+
+    return program;
+}
+
+} // namespace
+
+TEST_CASE("Intcode engines agree on the puzzle examples")
+{
+    using aoc::intcode::parse_program;
+
+    require_engines_agree(parse_program("1,9,10,3,2,3,11,0,99,30,40,50"));
+    require_engines_agree(parse_program("1,1,1,4,99,5,6,0,99"));
+    require_engines_agree(parse_program("1002,4,3,4,33"));
+    require_engines_agree(parse_program("109,1,204,-1,1001,100,1,100,1008,100,16,101,1006,101,0,99"));
+    require_engines_agree(parse_program("1102,34915192,34915192,7,4,7,99,0"));
+
+    auto compare_with_8 = parse_program(
+        "3,21,1008,21,8,20,1005,20,22,107,8,21,20,1006,20,31,1106,0,36,98,0,0,1002,21,125,20,4,20,"
+        "1105,1,46,104,999,1105,1,46,1101,1000,1,20,4,20,1105,1,46,98,99");
+
+    for (word input : {7, 8, 9}) {
+        require_engines_agree(compare_with_8, {input});
+    }
+
+    // Runs out of input half way.
+    require_engines_agree(parse_program("3,13,1002,13,2,13,4,13,1105,1,0,99,99,0"), {1, 2, 3});
+}
+
+TEST_CASE("Intcode engines agree on loops")
+{
+    using aoc::intcode::parse_program;
+
+    // Countdown sum, with the counter and the total on pages of their own.
+    auto sum = parse_program("1,1101,600,1101,1001,600,-1,600,1005,600,0,4,1101,99");
+    sum.resize(1200);
+    sum[600] = 1000;
+    require_engines_agree(sum);
+
+    // Increments its own immediate operand on every pass.
+    require_engines_agree(parse_program("1001,5,1,5,104,0,1001,20,-1,20,1005,20,0,99,0,0,0,0,0,0,3"));
+
+    // Rewrites the add at 0 on every pass, so its translation is dropped each time.
+    require_engines_agree(parse_program("1101,0,0,17,1001,1,1,1,1001,16,-1,16,1005,16,0,99,2000,0"));
+}
+
+TEST_CASE("Intcode engines agree on errors")
+{
+    using aoc::intcode::parse_program;
+
+    require_engines_agree(parse_program("1,0,0,0,42"));
+    require_engines_agree(parse_program("1,-1,0,0,99"));
+    require_engines_agree(parse_program("11101,1,1,0,99"));
+    require_engines_agree(parse_program("301,0,0,0,99"));
+    require_engines_agree(parse_program("1105,1,-7"));
+    require_engines_agree(parse_program("105,0,-7,99"));
+}
+
+TEST_CASE("Intcode engines agree on generated programs")
+{
+    std::mt19937 rng{2019};
+
+    for (int i = 0; i < 500; ++i) {
+        require_engines_agree(random_program(rng, false), {5, -3, 8});
+        require_engines_agree(random_program(rng, true), {5, -3, 8});
+    }
+}
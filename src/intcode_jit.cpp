@@ -0,0 +1,567 @@
+
+#include "intcode.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#if (defined(__x86_64__) || defined(_M_X64))                                                          \
+    && (defined(_WIN32) || defined(__unix__) || defined(__APPLE__))
+#define AOC_INTCODE_JIT 1
+#else
+#define AOC_INTCODE_JIT 0
+#endif
+
+#if AOC_INTCODE_JIT
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+#endif
+
+namespace aoc::intcode {
+
+namespace detail {
+
+#if AOC_INTCODE_JIT
+
+    namespace {
+
+        // Page aligned memory that is writable while code is appended and executable otherwise.
+        class executable_buffer {
+        public:
+            static constexpr std::size_t capacity = 64 * 1024;
+
+            executable_buffer()
+            {
+#ifdef _WIN32
+                data_ = static_cast<std::uint8_t*>(
+                    ::VirtualAlloc(nullptr, capacity, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+                if (data_ == nullptr) throw std::runtime_error{"Unable to allocate JIT code buffer"};
+#else
+                void* data = ::mmap(
+                    nullptr, capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (data == MAP_FAILED) throw std::runtime_error{"Unable to allocate JIT code buffer"};
+
+                data_ = static_cast<std::uint8_t*>(data);
+#endif
+                protect(false);
+            }
+
+            ~executable_buffer()
+            {
+#ifdef _WIN32
+                ::VirtualFree(data_, 0, MEM_RELEASE);
+#else
+                ::munmap(data_, capacity);
+#endif
+            }
+
+            executable_buffer(const executable_buffer&)            = delete;
+            executable_buffer& operator=(const executable_buffer&) = delete;
+
+            bool fits(std::size_t size) const { return used_ + size <= capacity; }
+
+            // Forgets the code appended so far.
+            void reset() { used_ = 0; }
+
+            const void* append(const std::vector<std::uint8_t>& code)
+            {
+                protect(true);
+
+                auto* start = data_ + used_;
+                std::memcpy(start, code.data(), code.size());
+                used_ += code.size();
+
+                protect(false);
+
+                return start;
+            }
+
+        private:
+            void protect(bool writable)
+            {
+#ifdef _WIN32
+                DWORD previous = 0;
+                ::VirtualProtect(
+                    data_, capacity, writable ? PAGE_READWRITE : PAGE_EXECUTE_READ, &previous);
+                if (!writable) ::FlushInstructionCache(::GetCurrentProcess(), data_, capacity);
+#else
+                ::mprotect(data_, capacity, writable ? PROT_READ | PROT_WRITE : PROT_READ | PROT_EXEC);
+#endif
+            }
+
+            std::uint8_t* data_ = nullptr;
+            std::size_t   used_ = 0;
+        };
+
+        // Buffers released by one cache are handed to the next, so forks and other short lived machines
+        // do not map and unmap a buffer each. Never destroyed, caches can outlive static destruction.
+        class spare_buffers {
+        public:
+            static constexpr std::size_t max_spares = 16;
+
+            static std::unique_ptr<executable_buffer> acquire()
+            {
+                auto& s = instance();
+                {
+                    std::lock_guard lock{s.mutex_};
+                    if (!s.buffers_.empty()) {
+                        auto buffer = std::move(s.buffers_.back());
+                        s.buffers_.pop_back();
+                        buffer->reset();
+                        return buffer;
+                    }
+                }
+
+                return std::make_unique<executable_buffer>();
+            }
+
+            static void release(std::unique_ptr<executable_buffer> buffer) noexcept
+            {
+                auto& s = instance();
+
+                std::lock_guard lock{s.mutex_};
+                if (s.buffers_.size() < max_spares) { s.buffers_.push_back(std::move(buffer)); }
+            }
+
+        private:
+            spare_buffers() { buffers_.reserve(max_spares); }
+
+            static spare_buffers& instance()
+            {
+                static auto* spares = new spare_buffers;
+                return *spares;
+            }
+
+            std::mutex                                      mutex_;
+            std::vector<std::unique_ptr<executable_buffer>> buffers_;
+        };
+
+        // Just enough of an x86-64 assembler for the translated blocks. r11 holds the block's slot
+        // table, an array of pointers to the memory cells its position operands name, r10 the current
+        // slot and rax, rdx and r8 the operands. All of them are scratch registers in both the System V
+        // and the Windows calling conventions, so blocks need neither a frame nor unwind information.
+        class assembler {
+        public:
+            enum reg : std::uint8_t { rax = 0, rdx = 2 };
+
+            void prologue()
+            {
+#ifdef _WIN32
+                emit({0x49, 0x89, 0xCB}); // mov r11, rcx
+#else
+                emit({0x49, 0x89, 0xFB}); // mov r11, rdi
+#endif
+            }
+
+            // mov r, value
+            void load_constant(reg r, word value)
+            {
+                if (value >= std::numeric_limits<std::int32_t>::min()
+                    && value <= std::numeric_limits<std::int32_t>::max()) {
+                    emit({0x48, 0xC7, static_cast<std::uint8_t>(0xC0 | r)});
+                    emit_value(static_cast<std::int32_t>(value));
+                }
+                else {
+                    emit({0x48, static_cast<std::uint8_t>(0xB8 + r)});
+                    emit_value(value);
+                }
+            }
+
+            // mov r10, [r11 + 8 * slot]; mov r, [r10]
+            void load_slot(reg r, std::size_t slot)
+            {
+                slot_pointer(slot);
+                emit({0x49, 0x8B, static_cast<std::uint8_t>(r << 3 | 0x02)});
+            }
+
+            // mov r10, [r11 + 8 * slot]; mov [r10], rax
+            void store_slot(std::size_t slot)
+            {
+                slot_pointer(slot);
+                emit({0x49, 0x89, 0x02});
+            }
+
+            void add() { emit({0x48, 0x01, 0xD0}); }            // add rax, rdx
+            void multiply() { emit({0x48, 0x0F, 0xAF, 0xC2}); } // imul rax, rdx
+
+            // rax = rax < rdx or rax == rdx, as 0 or 1
+            void compare(bool equals)
+            {
+                emit({0x48, 0x39, 0xD0});                                            // cmp rax, rdx
+                emit({0x0F, static_cast<std::uint8_t>(equals ? 0x94 : 0x9C), 0xC0}); // sete / setl al
+                emit({0x0F, 0xB6, 0xC0});                                            // movzx eax, al
+            }
+
+            // Returns rdx when rax is non-zero (or zero, for jump_if_zero) and next otherwise.
+            void return_jump(bool jump_if_zero, std::size_t next)
+            {
+                emit({0x49, 0xB8}); // mov r8, next
+                emit_value(static_cast<std::uint64_t>(next));
+                emit({0x48, 0x85, 0xC0}); // test rax, rax
+                emit({0x48, 0x89, 0xD0}); // mov rax, rdx
+                // cmovne / cmove rax, r8
+                emit({0x49, 0x0F, static_cast<std::uint8_t>(jump_if_zero ? 0x45 : 0x44), 0xC0});
+                emit({0xC3});
+            }
+
+            void return_address(std::size_t next)
+            {
+                load_constant(rax, static_cast<word>(next));
+                emit({0xC3});
+            }
+
+            const std::vector<std::uint8_t>& code() const { return code_; }
+
+        private:
+            void emit(std::initializer_list<std::uint8_t> bytes) { code_.insert(code_.end(), bytes); }
+
+            template <typename T>
+            void emit_value(T value)
+            {
+                std::uint8_t bytes[sizeof(T)];
+                std::memcpy(bytes, &value, sizeof(T));
+                code_.insert(code_.end(), std::begin(bytes), std::end(bytes));
+            }
+
+            void slot_pointer(std::size_t slot)
+            {
+                auto displacement = static_cast<std::int32_t>(slot * sizeof(word*));
+
+                if (displacement < 128) {
+                    emit({0x4D, 0x8B, 0x53, static_cast<std::uint8_t>(displacement)});
+                }
+                else {
+                    emit({0x4D, 0x8B, 0x93});
+                    emit_value(displacement);
+                }
+            }
+
+            std::vector<std::uint8_t> code_;
+        };
+
+    } // namespace
+
+    struct jit_block {
+        using entry_point = std::size_t (*)(word* const*);
+
+        std::size_t   start        = 0;
+        std::size_t   end          = 0;
+        std::uint64_t instructions = 0;
+        entry_point   entry        = nullptr;
+        bool          live         = true;
+
+        std::vector<std::size_t>  slot_addresses;
+        std::vector<std::uint8_t> slot_written;
+        std::vector<std::size_t>  writes;
+
+        // Slot table and the memory generation it was resolved under.
+        std::vector<word*> slots;
+        std::uint64_t      generation = 0;
+    };
+
+    struct jit_cache {
+        static constexpr std::size_t max_block_length = 64;
+
+        // Self-modifying code can keep retranslating the same cells, past this many dead blocks the
+        // whole cache starts over.
+        static constexpr std::size_t max_dead_blocks = 1024;
+
+        static constexpr std::int32_t not_compiled   = -1;
+        static constexpr std::int32_t not_compilable = -2;
+
+        std::vector<std::unique_ptr<executable_buffer>> buffers;
+        std::vector<jit_block>                          blocks;
+        std::vector<std::int32_t>                       block_at;
+        std::size_t                                     dead_blocks = 0;
+
+        // Translates the longest supported run of instructions starting at start. Returns the new
+        // block's index, or not_compilable when the first instruction is left to the interpreter.
+        std::int32_t compile(const paged_memory& memory, std::size_t start);
+
+        void invalidate(std::size_t address) noexcept
+        {
+            if (address < block_at.size() && block_at[address] == not_compilable) {
+                block_at[address] = not_compiled;
+            }
+
+            for (auto& block : blocks) {
+                if (block.live && block.start <= address && address < block.end) {
+                    block.live            = false;
+                    block_at[block.start] = not_compiled;
+                    ++dead_blocks;
+                }
+            }
+        }
+
+        jit_cache() = default;
+        ~jit_cache() { clear(); }
+
+        jit_cache(const jit_cache&)            = delete;
+        jit_cache& operator=(const jit_cache&) = delete;
+
+        void clear() noexcept
+        {
+            for (auto& buffer : buffers) {
+                spare_buffers::release(std::move(buffer));
+            }
+
+            buffers.clear();
+            blocks.clear();
+            block_at.clear();
+            dead_blocks = 0;
+        }
+    };
+
+    std::int32_t jit_cache::compile(const paged_memory& memory, std::size_t start)
+    {
+        jit_block block;
+        block.start = start;
+
+        auto slot = [&block](std::size_t address, bool written) {
+            auto it = std::ranges::find(block.slot_addresses, address);
+            if (it == block.slot_addresses.end()) {
+                block.slot_addresses.push_back(address);
+                block.slot_written.push_back(0);
+                it = block.slot_addresses.end() - 1;
+            }
+
+            auto index = static_cast<std::size_t>(it - block.slot_addresses.begin());
+            if (written && !block.slot_written[index]) {
+                block.slot_written[index] = 1;
+                block.writes.push_back(address);
+            }
+
+            return index;
+        };
+
+        assembler a;
+        a.prologue();
+
+        // Position operands need a non-negative address and relative ones a runtime base, anything
+        // else is left for the interpreter to execute or reject.
+        auto operand_supported = [&memory](word instruction, std::size_t ip, std::size_t i) {
+            auto mode = instruction / (i == 1 ? 100 : 1000) % 10;
+            return mode == 1 || (mode == 0 && memory.read(ip + i) >= 0);
+        };
+
+        auto load = [&](assembler::reg r, word instruction, std::size_t ip, std::size_t i) {
+            auto mode  = instruction / (i == 1 ? 100 : 1000) % 10;
+            auto value = memory.read(ip + i);
+
+            if (mode == 1) { a.load_constant(r, value); }
+            else {
+                a.load_slot(r, slot(static_cast<std::size_t>(value), false));
+            }
+        };
+
+        auto ip         = start;
+        bool terminated = false;
+
+        while (block.instructions < max_block_length) {
+            auto instruction = memory.read(ip);
+            if (instruction < 0) break;
+
+            auto opcode = instruction % 100;
+
+            if (opcode == 1 || opcode == 2 || opcode == 7 || opcode == 8) {
+                if (!operand_supported(instruction, ip, 1) || !operand_supported(instruction, ip, 2)
+                    || instruction / 10000 % 10 != 0 || memory.read(ip + 3) < 0) {
+                    break;
+                }
+
+                load(assembler::rax, instruction, ip, 1);
+                load(assembler::rdx, instruction, ip, 2);
+
+                switch (opcode) {
+                    case 1: a.add(); break;
+                    case 2: a.multiply(); break;
+                    case 7: a.compare(false); break;
+                    case 8: a.compare(true); break;
+                }
+
+                auto target = static_cast<std::size_t>(memory.read(ip + 3));
+                a.store_slot(slot(target, true));
+
+                ++block.instructions;
+                ip += 4;
+
+                // A write at or after this instruction may change code still to come in this block.
+                if (target >= ip - 4) break;
+            }
+            else if (opcode == 5 || opcode == 6) {
+                if (!operand_supported(instruction, ip, 1) || !operand_supported(instruction, ip, 2)) {
+                    break;
+                }
+
+                load(assembler::rax, instruction, ip, 1);
+                load(assembler::rdx, instruction, ip, 2);
+                a.return_jump(opcode == 6, ip + 3);
+
+                ++block.instructions;
+                ip += 3;
+                terminated = true;
+                break;
+            }
+            else {
+                break;
+            }
+        }
+
+        if (block.instructions == 0) return not_compilable;
+
+        if (!terminated) { a.return_address(ip); }
+
+        block.end = ip;
+
+        if (buffers.empty() || !buffers.back()->fits(a.code().size())) {
+            buffers.push_back(spare_buffers::acquire());
+        }
+
+        auto* code  = const_cast<void*>(buffers.back()->append(a.code()));
+        block.entry = reinterpret_cast<jit_block::entry_point>(code);
+        block.slots.resize(block.slot_addresses.size());
+
+        blocks.push_back(std::move(block));
+
+        return static_cast<std::int32_t>(blocks.size() - 1);
+    }
+
+#else
+
+    struct jit_cache {
+        void invalidate(std::size_t) noexcept {}
+    };
+
+#endif
+
+    jit_cache_ptr::jit_cache_ptr() noexcept = default;
+
+    jit_cache_ptr::jit_cache_ptr(const jit_cache_ptr&) noexcept {}
+
+    jit_cache_ptr::jit_cache_ptr(jit_cache_ptr&& other) noexcept = default;
+
+    jit_cache_ptr& jit_cache_ptr::operator=(const jit_cache_ptr&) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    jit_cache_ptr& jit_cache_ptr::operator=(jit_cache_ptr&& other) noexcept = default;
+
+    jit_cache_ptr::~jit_cache_ptr() = default;
+
+    jit_cache& jit_cache_ptr::get_or_create()
+    {
+        if (!cache_) { cache_ = std::make_unique<jit_cache>(); }
+
+        return *cache_;
+    }
+
+    void jit_cache_ptr::reset() noexcept
+    {
+        cache_.reset();
+    }
+
+    void jit_cache_ptr::invalidate(std::size_t address) noexcept
+    {
+        if (cache_) cache_->invalidate(address);
+    }
+
+} // namespace detail
+
+bool jit_supported()
+{
+    return AOC_INTCODE_JIT == 1;
+}
+
+#if AOC_INTCODE_JIT
+
+status vm::run_jit()
+{
+    static constexpr word zero = 0;
+
+    auto& cache = jit_.get_or_create();
+
+    for (;;) {
+        if (cache.dead_blocks > detail::jit_cache::max_dead_blocks) { cache.clear(); }
+
+        detail::jit_block* block = nullptr;
+
+        // Addresses past the end of memory hold no code, the interpreter reports them.
+        if (ip_ < memory_.size()) {
+            if (cache.block_at.size() <= ip_) {
+                auto size = std::max({ip_ + 1, cache.block_at.size() * 2, std::size_t{64}});
+                cache.block_at.resize(size, detail::jit_cache::not_compiled);
+            }
+
+            auto& index = cache.block_at[ip_];
+
+            if (index == detail::jit_cache::not_compiled) {
+                index = cache.compile(memory_, ip_);
+
+                // Instructions left to the interpreter are retried once their opcode cell changes.
+                auto end = index >= 0 ? cache.blocks[static_cast<std::size_t>(index)].end : ip_ + 1;
+                if (code_cells_.size() < end) { code_cells_.resize(end); }
+
+                std::fill(
+                    code_cells_.begin() + static_cast<std::ptrdiff_t>(ip_),
+                    code_cells_.begin() + static_cast<std::ptrdiff_t>(end),
+                    std::uint8_t{1});
+            }
+
+            if (index >= 0) { block = &cache.blocks[static_cast<std::size_t>(index)]; }
+        }
+
+        if (block == nullptr) {
+            if (step() != status::ready) return state_;
+            continue;
+        }
+
+        if (block->generation != memory_.generation()) {
+            // Written cells first, unsharing a page can move cells that are only read.
+            for (std::size_t i = 0; i < block->slots.size(); ++i) {
+                if (block->slot_written[i]) {
+                    block->slots[i] = &memory_.writable(block->slot_addresses[i]);
+                }
+            }
+
+            for (std::size_t i = 0; i < block->slots.size(); ++i) {
+                if (block->slot_written[i]) continue;
+
+                auto* cell      = memory_.find(block->slot_addresses[i]);
+                block->slots[i] = const_cast<word*>(cell != nullptr ? cell : &zero);
+            }
+
+            block->generation = memory_.generation();
+        }
+
+        ip_ = block->entry(block->slots.data());
+        executed_ += block->instructions;
+
+        for (auto address : block->writes) {
+            if (address < code_cells_.size() && code_cells_[address] != 0) { invalidate_code(address); }
+        }
+    }
+}
+
+#else
+
+status vm::run_jit()
+{
+    return run_threaded();
+}
+
+#endif
+
+} // namespace aoc::intcode
@@ -0,0 +1,145 @@
+#include "intcode_network.hpp"
+
+#include <utility>
+
+namespace aoc::intcode {
+
+namespace {
+
+    std::int64_t now()
+    {
+        auto since_epoch = std::chrono::steady_clock::now().time_since_epoch();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch).count();
+    }
+
+} // namespace
+
+network::network(router route)
+    : route_{std::move(route)}
+{
+}
+
+std::size_t network::add(std::span<const word> program, intcode::engine engine)
+{
+    auto index = nodes_.size();
+    nodes_.push_back(std::make_unique<node>(vm{program, engine}));
+
+    // New machines run until they first need input.
+    nodes_.back()->scheduled.store(true);
+    ready_.push_back(index);
+
+    return index;
+}
+
+void network::send(std::size_t to, word value)
+{
+    auto& n = *nodes_.at(to);
+
+    n.mailbox.push(value);
+    messages_.fetch_add(1, std::memory_order_relaxed);
+
+    // Pairs with the fence in run_node, so either this sees the machine parked or the machine sees the
+    // value before parking.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (!n.scheduled.exchange(true)) { schedule(to); }
+}
+
+void network::schedule(std::size_t index)
+{
+    if (pool_ != nullptr) {
+        pool_->submit([this, index] { run_node(index); });
+        return;
+    }
+
+    ready_.push_back(index);
+}
+
+void network::run_node(std::size_t index)
+{
+    auto& n = *nodes_[index];
+
+    while (true) {
+        while (auto value = n.mailbox.try_pop()) {
+            n.machine.push_input(*value);
+        }
+
+        n.machine.run();
+
+        while (n.machine.has_output()) {
+            route_(*this, index, n.machine.pop_output());
+        }
+
+        n.scheduled.store(false);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        // A value that arrived after the mailbox was drained, either from a sender that saw the machine
+        // still scheduled or from this machine's own outputs, has to be picked up before parking.
+        if (n.mailbox.empty() || n.scheduled.exchange(true)) break;
+    }
+
+    // Workers can finish out of order, keep the latest park.
+    auto parked = now();
+    auto latest = last_park_.load(std::memory_order_relaxed);
+
+    while (latest < parked
+           && !last_park_.compare_exchange_weak(latest, parked, std::memory_order_relaxed)) {
+    }
+}
+
+void network::start()
+{
+    idle_detection_ = {};
+    last_park_.store(now(), std::memory_order_relaxed);
+}
+
+void network::finish()
+{
+    idle_detection_ = std::chrono::nanoseconds{now() - last_park_.load(std::memory_order_relaxed)};
+}
+
+void network::run()
+{
+    start();
+
+    while (!ready_.empty()) {
+        auto index = ready_.front();
+        ready_.pop_front();
+
+        run_node(index);
+    }
+
+    finish();
+}
+
+void network::run(work_stealing_pool& pool)
+{
+    start();
+
+    pool_ = &pool;
+
+    // Anything sent between runs is waiting in ready_.
+    for (; !ready_.empty(); ready_.pop_front()) {
+        auto index = ready_.front();
+        pool.submit([this, index] { run_node(index); });
+    }
+
+    try {
+        pool.wait();
+    }
+    catch (...) {
+        pool_ = nullptr;
+        throw;
+    }
+
+    pool_ = nullptr;
+
+    finish();
+}
+
+network::statistics network::stats() const
+{
+    return {messages_.load(std::memory_order_relaxed), idle_detection_};
+}
+
+} // namespace aoc::intcode
@@ -0,0 +1,118 @@
+#include <aoc/intcode_network.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace {
+
+using aoc::intcode::network;
+using aoc::intcode::word;
+
+// Wires five amplifiers in a chain, or a loop when feedback is set, and returns the last thruster
+// signal. Runs cooperatively unless given a pool.
+word amplify(
+    const std::vector<word>&     program,
+    const std::array<word, 5>&   phases,
+    bool                         feedback,
+    aoc::work_stealing_pool*     pool = nullptr)
+{
+    std::atomic<word> signal = 0;
+
+    network amplifiers{[&signal, feedback](network& net, std::size_t from, word value) {
+        if (from == 4) signal = value;
+        if (from < 4 || feedback) net.send((from + 1) % 5, value);
+    }};
+
+    for (auto phase : phases) {
+        amplifiers.send(amplifiers.add(program), phase);
+    }
+
+    amplifiers.send(0, 0);
+
+    if (pool) {
+        amplifiers.run(*pool);
+    }
+    else {
+        amplifiers.run();
+    }
+
+    for (std::size_t i = 0; i < amplifiers.size(); ++i) {
+        REQUIRE(aoc::intcode::status::halted == amplifiers.machine(i).state());
+    }
+
+    return signal;
+}
+
+} // namespace
+
+TEST_CASE("Can chain Intcode machines through a network")
+{
+    using aoc::intcode::parse_program;
+
+    auto chain    = parse_program("3,15,3,16,1002,16,10,16,1,16,15,15,4,15,99,0,0");
+    auto feedback = parse_program(
+        "3,26,1001,26,-4,26,3,27,1002,27,2,27,1,27,26,27,4,27,1001,28,-1,28,1005,28,6,99,0,0,5");
+
+    aoc::work_stealing_pool pool{4};
+
+    REQUIRE(43210 == amplify(chain, {4, 3, 2, 1, 0}, false));
+    REQUIRE(43210 == amplify(chain, {4, 3, 2, 1, 0}, false, &pool));
+
+    REQUIRE(139629729 == amplify(feedback, {9, 8, 7, 6, 5}, true));
+    REQUIRE(139629729 == amplify(feedback, {9, 8, 7, 6, 5}, true, &pool));
+}
+
+TEST_CASE("Parked Intcode machines wake when a message arrives")
+{
+    using aoc::intcode::parse_program;
+
+    // Decrements every value it receives and passes it on, halting once it reaches zero.
+    auto relay = parse_program("3,100,1001,100,-1,100,4,100,1005,100,0,99");
+
+    constexpr std::size_t nodes = 50;
+
+    std::atomic<int> halted = 0;
+
+    network ring{[&halted](network& net, std::size_t from, word value) {
+        if (value == 0) {
+            ++halted;
+            return;
+        }
+
+        net.send((from + 1) % nodes, value);
+    }};
+
+    for (std::size_t i = 0; i < nodes; ++i) {
+        ring.add(relay);
+    }
+
+    // Nothing to do until a message arrives, so every machine parks.
+    ring.run();
+    REQUIRE(0 == ring.stats().messages);
+
+    for (std::size_t i = 0; i < nodes; ++i) {
+        REQUIRE(aoc::intcode::status::waiting_for_input == ring.machine(i).state());
+    }
+
+    aoc::work_stealing_pool pool{4};
+
+    ring.send(0, 10'000);
+    ring.run(pool);
+
+    REQUIRE(1 == halted);
+    REQUIRE(10'000 == ring.stats().messages);
+    REQUIRE(aoc::intcode::status::halted == ring.machine((10'000 - 1) % nodes).state());
+
+    // The token visited every machine, each still waiting for more until the one that finished it.
+    REQUIRE(aoc::intcode::status::waiting_for_input == ring.machine(0).state());
+
+    // More input after the network went idle picks up where it stopped.
+    ring.send(0, 3);
+    ring.run();
+
+    REQUIRE(2 == halted);
+    REQUIRE(10'003 == ring.stats().messages);
+}
@@ -1,8 +1,22 @@
-
 #include <aoc/intcode.hpp>
+#include <aoc/thread_pool.hpp>
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr auto engines = {
+    aoc::intcode::engine::interpreter,
+    aoc::intcode::engine::threaded,
+    aoc::intcode::engine::jit};
+
+} // namespace
+
 TEST_CASE("Can run simple intcode program")
 {
     std::vector<int> program{1, 9, 10, 3, 2, 3, 11, 0, 99, 30, 40, 50};
@@ -11,3 +25,256 @@ TEST_CASE("Can run simple intcode program")
 
     REQUIRE(3500 == program[0]);
 }
+
+TEST_CASE("Invalid opcodes are reported")
+{
+    REQUIRE_THROWS_AS(aoc::compute({1, 0, 0, 0, 42}), std::runtime_error);
+}
+
+TEST_CASE("Can parse an intcode program")
+{
+    auto program = aoc::intcode::parse_program("1102,34915192,34915192,7,4,7,99,0\n");
+
+    REQUIRE(8 == program.size());
+    REQUIRE(34915192 == program[1]);
+}
+
+TEST_CASE("Intcode machine supports parameter modes and comparisons")
+{
+    // Outputs 999 below 8, 1000 for 8 and 1001 above 8.
+    auto program = aoc::intcode::parse_program(
+        "3,21,1008,21,8,20,1005,20,22,107,8,21,20,1006,20,31,1106,0,36,98,0,0,1002,21,125,20,4,20,"
+        "1105,1,46,"
+        "104,999,1105,1,46,1101,1000,1,20,4,20,1105,1,46,98,99");
+
+    for (auto engine : engines) {
+        for (auto [input, expected] : {std::pair{7, 999}, std::pair{8, 1000}, std::pair{9, 1001}}) {
+            aoc::intcode::vm machine{program, engine};
+            machine.push_input(input);
+
+            REQUIRE(aoc::intcode::status::halted == machine.run());
+            REQUIRE(expected == machine.pop_output());
+            REQUIRE_FALSE(machine.has_output());
+        }
+    }
+}
+
+TEST_CASE("Intcode machine supports the relative base and growing memory")
+{
+    auto quine =
+        aoc::intcode::parse_program("109,1,204,-1,1001,100,1,100,1008,100,16,101,1006,101,0,99");
+
+    for (auto engine : engines) {
+        aoc::intcode::vm machine{quine, engine};
+
+        REQUIRE(aoc::intcode::status::halted == machine.run());
+        REQUIRE(quine == machine.take_outputs());
+        REQUIRE(machine.memory().size() > 101);
+
+        aoc::intcode::vm large{aoc::intcode::parse_program("104,1125899906842624,99"), engine};
+        large.run();
+
+        REQUIRE(1125899906842624 == large.pop_output());
+    }
+}
+
+TEST_CASE("Intcode machine pauses for input and resumes")
+{
+    // Echoes every input back doubled.
+    auto program = aoc::intcode::parse_program("3,13,1002,13,2,13,4,13,1105,1,0,99,99,0");
+
+    for (auto engine : engines) {
+        aoc::intcode::vm machine{program, engine};
+
+        REQUIRE(aoc::intcode::status::waiting_for_input == machine.run());
+        REQUIRE(0 == machine.instruction_pointer());
+
+        machine.push_input(21);
+        REQUIRE(aoc::intcode::status::waiting_for_input == machine.run());
+        REQUIRE(42 == machine.pop_output());
+
+        machine.push_input(5);
+        REQUIRE(aoc::intcode::status::waiting_for_input == machine.run());
+        REQUIRE(10 == machine.pop_output());
+    }
+}
+
+TEST_CASE("Intcode machine sees writes into its own code")
+{
+    // Increments the immediate operand of the output instruction at 4 before each of three passes.
+    auto program =
+        aoc::intcode::parse_program("1001,5,1,5,104,0,1001,20,-1,20,1005,20,0,99,0,0,0,0,0,0,3");
+
+    for (auto engine : engines) {
+        aoc::intcode::vm machine{program, engine};
+
+        REQUIRE(aoc::intcode::status::halted == machine.run());
+        REQUIRE(std::vector<aoc::intcode::word>{1, 2, 3} == machine.take_outputs());
+        REQUIRE(13 == machine.instructions_executed());
+    }
+
+    // The first add turns the 99 at 4 into a multiply.
+    for (auto engine : engines) {
+        aoc::intcode::vm machine{aoc::intcode::parse_program("1,1,1,4,99,5,6,0,99"), engine};
+        machine.run();
+
+        REQUIRE(30 == machine[0]);
+    }
+}
+
+TEST_CASE("Intcode machine rejects bad memory accesses")
+{
+    for (auto engine : engines) {
+        aoc::intcode::vm negative{aoc::intcode::parse_program("1,-1,0,0,99"), engine};
+        REQUIRE_THROWS_AS(negative.run(), std::out_of_range);
+
+        aoc::intcode::vm immediate_write{aoc::intcode::parse_program("11101,1,1,0,99"), engine};
+        REQUIRE_THROWS_AS(immediate_write.run(), std::runtime_error);
+
+        aoc::intcode::vm invalid{aoc::intcode::parse_program("1,0,0,0,42"), engine};
+        REQUIRE_THROWS_AS(invalid.run(), std::runtime_error);
+    }
+}
+
+TEST_CASE("Copies of Intcode memory share pages until written")
+{
+    std::vector<aoc::intcode::word> contents(aoc::intcode::paged_memory::page_size * 2 + 1, 7);
+
+    aoc::intcode::paged_memory image{contents};
+    REQUIRE(3 == image.unique_pages());
+
+    aoc::intcode::paged_memory copy{image};
+    REQUIRE(0 == copy.unique_pages());
+
+    copy.writable(1) = 42;
+    copy.writable(10'000) = 1;
+
+    REQUIRE(2 == copy.unique_pages());
+    REQUIRE(1 == image.unique_pages());
+
+    REQUIRE(42 == copy.read(1));
+    REQUIRE(7 == image.read(1));
+    REQUIRE(0 == image.read(10'000));
+    REQUIRE(10'001 == copy.size());
+}
+
+TEST_CASE("Forked Intcode machines run independently from a shared snapshot")
+{
+    using aoc::intcode::word;
+
+    // Adds every input into cell 101 and outputs the running total, with nine untouched pages behind.
+    auto program = aoc::intcode::parse_program("3,100,1,100,101,101,4,101,1105,1,0");
+    program.resize(aoc::intcode::paged_memory::page_size * 10);
+
+    for (auto engine : engines) {
+        aoc::intcode::vm machine{program, engine};
+        machine.push_input(5);
+
+        REQUIRE(aoc::intcode::status::waiting_for_input == machine.run());
+        REQUIRE(5 == machine.pop_output());
+
+        auto left  = machine.fork();
+        auto right = machine.fork();
+
+        REQUIRE(0 == left.memory().unique_pages());
+        REQUIRE(aoc::intcode::status::waiting_for_input == left.state());
+
+        // The parent's translated code must not write into the pages it now shares.
+        machine.push_input(100);
+        left.push_input(1);
+        right.push_input(10);
+
+        machine.run();
+        left.run();
+        right.run();
+
+        REQUIRE(105 == machine.pop_output());
+        REQUIRE(6 == left.pop_output());
+        REQUIRE(15 == right.pop_output());
+
+        REQUIRE(1 == left.memory().unique_pages());
+        REQUIRE(1 == right.memory().unique_pages());
+        REQUIRE(machine.instructions_executed() == left.instructions_executed());
+
+        // Assigning a snapshot back rewinds the machine.
+        auto saved = machine.fork();
+        machine.push_input(1000);
+        machine.run();
+        REQUIRE(1105 == machine.pop_output());
+
+        machine = saved;
+        machine.push_input(1);
+        machine.run();
+        REQUIRE(106 == machine.pop_output());
+        REQUIRE(106 == machine.read(101));
+    }
+}
+
+TEST_CASE("Can keep thousands of forked Intcode machines alive")
+{
+    auto program = aoc::intcode::parse_program("3,100,1,100,101,101,4,101,1105,1,0");
+    program.resize(aoc::intcode::paged_memory::page_size * 10);
+
+    aoc::intcode::vm root{program, aoc::intcode::engine::threaded};
+    root.run();
+
+    // Each level forks the whole frontier once more, like a breadth first search over inputs.
+    std::vector<aoc::intcode::vm> frontier{root};
+
+    for (int depth = 0; depth < 10; ++depth) {
+        std::vector<aoc::intcode::vm> next;
+
+        for (const auto& state : frontier) {
+            for (aoc::intcode::word input : {0, 1}) {
+                auto child = state.fork();
+                child.push_input(input << (9 - depth));
+                child.run();
+                child.pop_output();
+
+                next.push_back(std::move(child));
+            }
+        }
+
+        frontier = std::move(next);
+    }
+
+    REQUIRE(1024 == frontier.size());
+
+    for (std::size_t i = 0; i < frontier.size(); ++i) {
+        REQUIRE(static_cast<aoc::intcode::word>(i) == frontier[i].read(101));
+        REQUIRE(1 == frontier[i].memory().unique_pages());
+    }
+}
+
+TEST_CASE("Can run a batch of Intcode machines on one program")
+{
+    // Multiplies its two immediate operands into cell 0.
+    auto program = aoc::intcode::parse_program("1102,0,0,0,99");
+
+    aoc::work_stealing_pool pool{4};
+
+    for (auto engine : engines) {
+        auto products = aoc::intcode::run_batch(
+            program,
+            100,
+            [](std::size_t index, aoc::intcode::vm& machine) {
+                machine[1] = static_cast<aoc::intcode::word>(index / 10);
+                machine[2] = static_cast<aoc::intcode::word>(index % 10);
+            },
+            [](std::size_t, aoc::intcode::vm& machine) { return machine[0]; },
+            pool,
+            engine);
+
+        REQUIRE(100 == products.size());
+        REQUIRE(0 == products[9]);
+        REQUIRE(12 == products[34]);
+        REQUIRE(81 == products[99]);
+    }
+
+    auto outputs = aoc::intcode::run_batch(
+        aoc::intcode::parse_program("4,3,99,0"), 3, [](std::size_t index, aoc::intcode::vm& machine) {
+            machine[3] = static_cast<aoc::intcode::word>(index + 4);
+        });
+
+    REQUIRE(std::vector<std::vector<aoc::intcode::word>>{{4}, {5}, {6}} == outputs);
+}
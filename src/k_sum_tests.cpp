@@ -0,0 +1,74 @@
+#include <aoc/k_sum.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+TEST_CASE("Can find pairs and triples summing to a target")
+{
+    std::vector<int> values{1721, 979, 366, 299, 675, 1456};
+
+    REQUIRE(std::vector{299, 1721} == aoc::first_k_sum(values, 2, 2020));
+    REQUIRE(std::vector{366, 675, 979} == aoc::first_k_sum(values, 3, 2020));
+    REQUIRE(std::vector{675} == aoc::first_k_sum(values, 1, 675));
+
+    REQUIRE_FALSE(aoc::first_k_sum(values, 2, 2021));
+    REQUIRE_FALSE(aoc::first_k_sum(values, 7, 2020));
+    REQUIRE_FALSE(aoc::first_k_sum(std::vector<int>{}, 2, 0));
+}
+
+TEST_CASE("A value is used only as often as it occurs")
+{
+    REQUIRE_FALSE(aoc::first_k_sum(std::vector{1010, 5}, 2, 2020));
+    REQUIRE(std::vector{1010, 1010} == aoc::first_k_sum(std::vector{1010, 5, 1010}, 2, 2020));
+
+    REQUIRE_FALSE(aoc::first_k_sum(std::vector{2, 2, 9}, 3, 6));
+    REQUIRE(std::vector{2, 2, 2} == aoc::first_k_sum(std::vector{2, 9, 2, 2}, 3, 6));
+}
+
+TEST_CASE("Every combination of values is found once")
+{
+    using solutions = std::vector<std::vector<int>>;
+
+    // Dense values, counted in a table.
+    std::vector dense{1, 2, 3, 3, 3, 4, 5, 5};
+    std::vector signed_dense{-2, -1, 0, 1, 1, 2};
+
+    REQUIRE(solutions{{1, 5}, {2, 4}, {3, 3}} == aoc::all_k_sums(dense, 2, 6));
+    REQUIRE(solutions{{-2, 0, 2}, {-2, 1, 1}, {-1, 0, 1}} == aoc::all_k_sums(signed_dense, 3, 0));
+    REQUIRE(solutions{{1, 2, 3, 4}} == aoc::all_k_sums(std::vector{4, 3, 2, 1}, 4, 10));
+
+    // Sparse values, sorted.
+    std::vector<std::int64_t> sparse{
+        -4'000'000'000, 3, 4'000'000'003, 1'000'000'000'000, 2'000'000'000'000};
+
+    REQUIRE(std::vector<std::vector<std::int64_t>>{{-4'000'000'000, 4'000'000'003}}
+            == aoc::all_k_sums(sparse, 2, 3));
+    REQUIRE(std::vector<std::vector<std::int64_t>>{{3, 1'000'000'000'000, 2'000'000'000'000}}
+            == aoc::all_k_sums(sparse, 3, 3'000'000'000'003));
+}
+
+TEST_CASE("The search stops when asked to")
+{
+    int visited = 0;
+    aoc::for_each_k_sum(std::vector{1, 2, 3, 4, 5, 6}, 2, 7, [&visited](std::span<const int>) {
+        return ++visited < 2;
+    });
+
+    REQUIRE(2 == visited);
+}
+
+TEST_CASE("Can search a large expense report")
+{
+    // Hundreds of thousands of distinct even entries in a bounded range. With two odd ones, the only
+    // triple reaching an even target below three of the even entries is both odd ones and one even.
+    std::vector<int> values{1, 3};
+    for (std::int64_t i = 0; i < 300'000; ++i) {
+        values.push_back(static_cast<int>(i * 7919 % 600'000) * 2 + 1'000'000);
+    }
+
+    REQUIRE(std::vector{1, 3, 1'000'000} == aoc::first_k_sum(values, 3, 1'000'004));
+    REQUIRE(1 == aoc::all_k_sums(values, 3, 1'000'004).size());
+}
@@ -0,0 +1,49 @@
+
+#include "runner.hpp"
+
+#include <map>
+#include <utility>
+
+namespace aoc {
+
+std::vector<solver_entry>& solver_registry()
+{
+    static std::vector<solver_entry> registry;
+    return registry;
+}
+
+namespace {
+
+    std::map<std::pair<int, int>, std::string_view>& embedded_inputs()
+    {
+        static std::map<std::pair<int, int>, std::string_view> inputs;
+        return inputs;
+    }
+
+} // namespace
+
+void register_embedded_input(int year, int day, std::string_view contents)
+{
+    embedded_inputs()[{year, day}] = contents;
+}
+
+std::optional<std::string_view> embedded_input(int year, int day)
+{
+    auto it = embedded_inputs().find({year, day});
+    if (it == embedded_inputs().end()) return std::nullopt;
+
+    return it->second;
+}
+
+std::optional<puzzle_input> load_puzzle_input(const std::filesystem::path& input_dir, int year, int day)
+{
+    if (auto embedded = embedded_input(year, day)) { return puzzle_input{*embedded}; }
+
+    auto path = input_dir / std::to_string(year) / fmt::format("day{:02}", day) / "puzzle.in";
+
+    if (!std::filesystem::is_regular_file(path)) { return std::nullopt; }
+
+    return puzzle_input{mapped_file{path}};
+}
+
+} // namespace aoc
@@ -0,0 +1,138 @@
+
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace aoc {
+
+namespace {
+
+    thread_local const work_stealing_pool* current_pool  = nullptr;
+    thread_local std::size_t               current_index = 0;
+
+} // namespace
+
+work_stealing_pool::work_stealing_pool(std::size_t thread_count)
+{
+    thread_count = std::max<std::size_t>(thread_count, 1);
+
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        queues_.push_back(std::make_unique<worker_queue>());
+    }
+
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        threads_.emplace_back([this, i] { run(i); });
+    }
+}
+
+work_stealing_pool::~work_stealing_pool()
+{
+    {
+        std::lock_guard lock{mutex_};
+        stopping_ = true;
+    }
+
+    work_available_.notify_all();
+
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void work_stealing_pool::submit(task t)
+{
+    // tasks spawned from a worker stay on that worker's deque, everything else is dealt round robin
+    auto index = (current_pool == this) ? current_index : next_queue_++ % queues_.size();
+
+    // count the task before publishing it so a fast worker can never finish it before it is counted
+    {
+        std::lock_guard lock{mutex_};
+        ++queued_;
+        ++unfinished_;
+    }
+
+    {
+        std::lock_guard lock{queues_[index]->mutex};
+        queues_[index]->tasks.push_back(std::move(t));
+    }
+
+    work_available_.notify_one();
+}
+
+void work_stealing_pool::wait()
+{
+    std::unique_lock lock{mutex_};
+    all_done_.wait(lock, [this] { return unfinished_ == 0; });
+
+    if (first_error_) { std::rethrow_exception(std::exchange(first_error_, nullptr)); }
+}
+
+bool work_stealing_pool::pop_local(std::size_t index, task& t)
+{
+    auto& queue = *queues_[index];
+
+    std::lock_guard lock{queue.mutex};
+    if (queue.tasks.empty()) return false;
+
+    t = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+
+    return true;
+}
+
+bool work_stealing_pool::steal(std::size_t thief, task& t)
+{
+    for (std::size_t offset = 1; offset < queues_.size(); ++offset) {
+        auto& queue = *queues_[(thief + offset) % queues_.size()];
+
+        std::lock_guard lock{queue.mutex};
+        if (queue.tasks.empty()) continue;
+
+        t = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+
+        return true;
+    }
+
+    return false;
+}
+
+void work_stealing_pool::run(std::size_t index)
+{
+    current_pool  = this;
+    current_index = index;
+
+    while (true) {
+        task t;
+
+        if (pop_local(index, t) || steal(index, t)) {
+            {
+                std::lock_guard lock{mutex_};
+                --queued_;
+            }
+
+            std::exception_ptr error;
+
+            try {
+                t();
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+
+            std::lock_guard lock{mutex_};
+            if (error && !first_error_) { first_error_ = error; }
+            if (--unfinished_ == 0) { all_done_.notify_all(); }
+
+            continue;
+        }
+
+        std::unique_lock lock{mutex_};
+        work_available_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+
+        if (stopping_ && queued_ == 0) return;
+    }
+}
+
+} // namespace aoc
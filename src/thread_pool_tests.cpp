@@ -0,0 +1,47 @@
+#include <aoc/thread_pool.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <stdexcept>
+
+TEST_CASE("Can run every submitted task before wait returns")
+{
+    aoc::work_stealing_pool pool{4};
+    std::atomic<int>        counter = 0;
+
+    for (int i = 0; i < 1000; ++i) {
+        pool.submit([&counter] { ++counter; });
+    }
+
+    pool.wait();
+
+    REQUIRE(1000 == counter);
+}
+
+TEST_CASE("Can submit tasks from inside a running task")
+{
+    aoc::work_stealing_pool pool{2};
+    std::atomic<int>        counter = 0;
+
+    for (int i = 0; i < 10; ++i) {
+        pool.submit([&pool, &counter] {
+            for (int j = 0; j < 10; ++j) {
+                pool.submit([&counter] { ++counter; });
+            }
+        });
+    }
+
+    pool.wait();
+
+    REQUIRE(100 == counter);
+}
+
+TEST_CASE("Can rethrow a task failure from wait")
+{
+    aoc::work_stealing_pool pool{2};
+
+    pool.submit([] { throw std::runtime_error{"task failed"}; });
+
+    REQUIRE_THROWS_AS(pool.wait(), std::runtime_error);
+}
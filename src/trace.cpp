@@ -0,0 +1,257 @@
+
+#include "trace.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace aoc::trace {
+
+namespace {
+
+    template <typename T>
+    using instrument_map = std::map<std::string, std::unique_ptr<T>, std::less<>>;
+
+    struct registry {
+        std::mutex                     mutex;
+        instrument_map<timer_data>     timers;
+        instrument_map<counter_data>   counters;
+        instrument_map<histogram_data> histograms;
+    };
+
+    registry& instruments()
+    {
+        static registry r;
+        return r;
+    }
+
+    template <typename T>
+    T& find_or_add(instrument_map<T>& map, std::string_view name)
+    {
+        std::lock_guard lock{instruments().mutex};
+
+        auto it = map.find(name);
+        if (it == map.end()) { it = map.emplace(std::string{name}, std::make_unique<T>()).first; }
+
+        return *it->second;
+    }
+
+    // Upper bound of the values that land in the bucket holding the given fraction of the samples.
+    std::uint64_t percentile(const histogram_data& h, double fraction)
+    {
+        auto samples = h.samples.load(std::memory_order_relaxed);
+        auto target  = static_cast<std::uint64_t>(fraction * static_cast<double>(samples));
+
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < histogram_data::bucket_count; ++i) {
+            seen += h.buckets[i].load(std::memory_order_relaxed);
+            if (seen > target) {
+                auto upper = i == 0 ? 0 : (i == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << i) - 1);
+                return std::min(upper, h.max.load(std::memory_order_relaxed));
+            }
+        }
+
+        return h.max.load(std::memory_order_relaxed);
+    }
+
+    std::string json_escape(std::string_view s)
+    {
+        std::string out;
+        for (char c : s) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out;
+    }
+
+} // namespace
+
+void histogram_data::record(std::uint64_t value)
+{
+    buckets[static_cast<std::size_t>(std::bit_width(value))].fetch_add(1, std::memory_order_relaxed);
+    samples.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(value, std::memory_order_relaxed);
+
+    auto lowest = min.load(std::memory_order_relaxed);
+    while (value < lowest && !min.compare_exchange_weak(lowest, value, std::memory_order_relaxed)) {}
+
+    auto highest = max.load(std::memory_order_relaxed);
+    while (value > highest && !max.compare_exchange_weak(highest, value, std::memory_order_relaxed)) {}
+}
+
+timer_data& timer(std::string_view name)
+{
+    return find_or_add(instruments().timers, name);
+}
+
+counter_data& counter(std::string_view name)
+{
+    return find_or_add(instruments().counters, name);
+}
+
+histogram_data& histogram(std::string_view name)
+{
+    return find_or_add(instruments().histograms, name);
+}
+
+void reset()
+{
+    auto& r = instruments();
+
+    std::lock_guard lock{r.mutex};
+
+    for (auto& [name, t] : r.timers) {
+        t->calls    = 0;
+        t->total_ns = 0;
+        t->max_ns   = 0;
+    }
+
+    for (auto& [name, c] : r.counters) {
+        c->value = 0;
+    }
+
+    for (auto& [name, h] : r.histograms) {
+        for (auto& bucket : h->buckets) {
+            bucket = 0;
+        }
+
+        h->samples = 0;
+        h->sum     = 0;
+        h->min     = std::numeric_limits<std::uint64_t>::max();
+        h->max     = 0;
+    }
+}
+
+std::string report_text()
+{
+    auto& r = instruments();
+
+    std::lock_guard lock{r.mutex};
+
+    std::string out;
+
+    if (!r.timers.empty()) {
+        out += fmt::format(
+            "{:<40} {:>10} {:>14} {:>14} {:>14}\n", "Timer", "calls", "total ms", "mean us", "max us");
+
+        for (const auto& [name, t] : r.timers) {
+            auto calls = t->calls.load();
+            auto total = static_cast<double>(t->total_ns.load());
+
+            out += fmt::format(
+                "{:<40} {:>10} {:>14.3f} {:>14.3f} {:>14.3f}\n",
+                name,
+                calls,
+                total / 1e6,
+                calls == 0 ? 0.0 : total / static_cast<double>(calls) / 1e3,
+                static_cast<double>(t->max_ns.load()) / 1e3);
+        }
+    }
+
+    if (!r.counters.empty()) {
+        out += fmt::format("{}{:<40} {:>10}\n", out.empty() ? "" : "\n", "Counter", "value");
+
+        for (const auto& [name, c] : r.counters) {
+            out += fmt::format("{:<40} {:>10}\n", name, c->value.load());
+        }
+    }
+
+    if (!r.histograms.empty()) {
+        out += fmt::format(
+            "{}{:<40} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10}\n",
+            out.empty() ? "" : "\n",
+            "Histogram",
+            "samples",
+            "mean",
+            "min",
+            "p50",
+            "p90",
+            "p99",
+            "max");
+
+        for (const auto& [name, h] : r.histograms) {
+            auto samples = h->samples.load();
+
+            out += fmt::format(
+                "{:<40} {:>10} {:>10.1f} {:>10} {:>10} {:>10} {:>10} {:>10}\n",
+                name,
+                samples,
+                samples == 0 ? 0.0 : static_cast<double>(h->sum.load()) / static_cast<double>(samples),
+                samples == 0 ? 0 : h->min.load(),
+                percentile(*h, 0.5),
+                percentile(*h, 0.9),
+                percentile(*h, 0.99),
+                h->max.load());
+        }
+    }
+
+    return out;
+}
+
+std::string report_json()
+{
+    auto& r = instruments();
+
+    std::lock_guard lock{r.mutex};
+
+    std::string out = "{\n  \"timers\": [";
+
+    const char* separator = "\n";
+    for (const auto& [name, t] : r.timers) {
+        out += fmt::format(
+            R"({}    {{"name": "{}", "calls": {}, "total_ns": {}, "max_ns": {}}})",
+            separator,
+            json_escape(name),
+            t->calls.load(),
+            t->total_ns.load(),
+            t->max_ns.load());
+        separator = ",\n";
+    }
+
+    out += "\n  ],\n  \"counters\": [";
+
+    separator = "\n";
+    for (const auto& [name, c] : r.counters) {
+        out += fmt::format(
+            R"({}    {{"name": "{}", "value": {}}})", separator, json_escape(name), c->value.load());
+        separator = ",\n";
+    }
+
+    out += "\n  ],\n  \"histograms\": [";
+
+    separator = "\n";
+    for (const auto& [name, h] : r.histograms) {
+        std::string buckets;
+        for (std::size_t i = 0; i < histogram_data::bucket_count; ++i) {
+            auto count = h->buckets[i].load();
+            if (count == 0) continue;
+
+            buckets +=
+                fmt::format(R"({}{{"bits": {}, "count": {}}})", buckets.empty() ? "" : ", ", i, count);
+        }
+
+        auto samples = h->samples.load();
+
+        out += fmt::format(
+            R"({}    {{"name": "{}", "samples": {}, "sum": {}, "min": {}, "max": {}, "buckets": [{}]}})",
+            separator,
+            json_escape(name),
+            samples,
+            h->sum.load(),
+            samples == 0 ? 0 : h->min.load(),
+            h->max.load(),
+            buckets);
+        separator = ",\n";
+    }
+
+    out += "\n  ]\n}\n";
+
+    return out;
+}
+
+} // namespace aoc::trace
@@ -0,0 +1,67 @@
+#include <aoc/trace.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <string>
+
+TEST_CASE("Can record named timers, counters and histograms")
+{
+    aoc::trace::reset();
+
+    {
+        aoc::trace::scoped_timer timer{aoc::trace::timer("tests/timer")};
+    }
+
+    aoc::trace::counter("tests/counter").add(3);
+    aoc::trace::counter("tests/counter").add(4);
+
+    for (std::uint64_t value : {0, 1, 5, 6, 100}) {
+        aoc::trace::histogram("tests/histogram").record(value);
+    }
+
+    REQUIRE(1 == aoc::trace::timer("tests/timer").calls);
+    REQUIRE(7 == aoc::trace::counter("tests/counter").value);
+
+    const auto& histogram = aoc::trace::histogram("tests/histogram");
+
+    REQUIRE(5 == histogram.samples);
+    REQUIRE(112 == histogram.sum);
+    REQUIRE(0 == histogram.min);
+    REQUIRE(100 == histogram.max);
+    REQUIRE(2 == histogram.buckets[3]);
+
+    auto text = aoc::trace::report_text();
+    REQUIRE(std::string::npos != text.find("tests/counter"));
+
+    auto json = aoc::trace::report_json();
+    REQUIRE(std::string::npos != json.find(R"("name": "tests/counter", "value": 7)"));
+
+    aoc::trace::reset();
+
+    REQUIRE(0 == aoc::trace::counter("tests/counter").value);
+    REQUIRE(0 == aoc::trace::histogram("tests/histogram").samples);
+}
+
+TEST_CASE("Trace macros compile in or out with AOC_TRACE")
+{
+    aoc::trace::reset();
+
+    int evaluated = 0;
+
+    {
+        AOC_TRACE_SCOPE("tests/macro scope");
+        AOC_TRACE_COUNT("tests/macro counter", ++evaluated);
+        AOC_TRACE_SAMPLE("tests/macro histogram", 42);
+    }
+
+    if constexpr (aoc::trace::enabled) {
+        REQUIRE(1 == evaluated);
+        REQUIRE(1 == aoc::trace::timer("tests/macro scope").calls);
+        REQUIRE(1 == aoc::trace::counter("tests/macro counter").value);
+        REQUIRE(42 == aoc::trace::histogram("tests/macro histogram").max);
+    }
+    else {
+        REQUIRE(0 == evaluated);
+    }
+}